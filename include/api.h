@@ -6,6 +6,8 @@
 void handleGetConfig(AsyncWebServerRequest *request);
 void handleGetLogs(AsyncWebServerRequest *request);
 void handleGetCurrentReadings(AsyncWebServerRequest *request);
+void handleGetStatus(AsyncWebServerRequest *request);
+void handleGetTrace(AsyncWebServerRequest *request);
 void handleSaveConfig(AsyncWebServerRequest *request);
 void handleResetConfig(AsyncWebServerRequest *request);
 void handleRestartDevice(AsyncWebServerRequest *request);
@@ -0,0 +1,37 @@
+#ifndef API_CACHE_H
+#define API_CACHE_H
+
+#include "config.h"
+#include <ArduinoJson.h>
+#include <ESPAsyncWebServer.h>
+
+struct EndpointGuard {
+    const char *nome;
+    uint8_t maxConcorrentes;
+    float taxaPorSegundo;
+    float rajada;
+    uint8_t emAndamento;
+    float tokens;
+    unsigned long ultimaRecarga;
+    uint32_t aceitas;
+    uint32_t naoModificadas;
+    uint32_t rejeitadas;
+};
+
+struct CachedResponse {
+    uint32_t versao;
+    bool valido;
+    size_t tamanho;
+    char etag[24];
+    char corpo[API_CACHE_SIZE];
+};
+
+typedef void (*JsonBuilder)(JsonDocument &doc);
+
+extern volatile uint32_t configVersion;
+
+void bumpConfigVersion();
+bool admitRequest(AsyncWebServerRequest *request, EndpointGuard &guard);
+void sendCachedJson(AsyncWebServerRequest *request, EndpointGuard &guard, CachedResponse &cache, uint32_t versao, JsonBuilder build);
+
+#endif // API_CACHE_H
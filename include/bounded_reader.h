@@ -0,0 +1,72 @@
+#ifndef BOUNDED_READER_H
+#define BOUNDED_READER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Leitor para deserializeJson() que para no limite de bytes ou no prazo total,
+// repassando ao stream apenas o tempo que ainda resta.
+template <typename TStream>
+struct BoundedReader {
+    TStream &stream;
+    size_t remaining;
+    unsigned long startTime;
+    unsigned long timeoutMs;
+    size_t consumed;
+    bool timedOut;
+
+    BoundedReader(TStream &stream, size_t limit, unsigned long timeoutMs)
+        : stream(stream), remaining(limit), startTime(millis()), timeoutMs(timeoutMs), consumed(0), timedOut(false) {}
+
+    int read() {
+        char c;
+        return readBytes(&c, 1) == 1 ? (uint8_t)c : -1;
+    }
+
+    size_t readBytes(char *buffer, size_t length) {
+        if (remaining == 0 || timedOut) {
+            return 0;
+        }
+        unsigned long elapsed = millis() - startTime;
+        if (elapsed >= timeoutMs) {
+            timedOut = true;
+            return 0;
+        }
+        stream.setTimeout(timeoutMs - elapsed);
+        size_t count = stream.readBytes(buffer, length < remaining ? length : remaining);
+        remaining -= count;
+        consumed += count;
+        if (count < length && remaining > 0 && millis() - startTime >= timeoutMs) {
+            timedOut = true;
+        }
+        return count;
+    }
+};
+
+struct BoundedJsonResult {
+    DeserializationError error;
+    size_t consumed;
+    bool tooLarge;
+    bool timedOut;
+};
+
+// Deserializa um corpo com Content-Length opcional (< 0 quando ausente).
+// Corpos declarados acima de maxSize são rejeitados sem ler nada.
+template <typename TStream>
+BoundedJsonResult deserializeBoundedJson(JsonDocument &doc, TStream &stream, int contentLength, size_t maxSize,
+                                         unsigned long timeoutMs, JsonDocument &filter, uint8_t nestingLimit) {
+    BoundedJsonResult result = {DeserializationError::Ok, 0, false, false};
+    if (contentLength >= 0 && (size_t)contentLength > maxSize) {
+        result.error = DeserializationError::IncompleteInput;
+        result.tooLarge = true;
+        return result;
+    }
+    BoundedReader<TStream> reader(stream, contentLength >= 0 ? (size_t)contentLength : maxSize, timeoutMs);
+    result.error = deserializeJson(doc, reader, DeserializationOption::Filter(filter),
+                                   DeserializationOption::NestingLimit(nestingLimit));
+    result.consumed = reader.consumed;
+    result.timedOut = reader.timedOut;
+    return result;
+}
+
+#endif // BOUNDED_READER_H
@@ -7,6 +7,37 @@
 #define DEBUG_MODE true
 #define MAX_LOGS 60
 #define WIFI_TIMEOUT 30000 // 30 segundos
+#define LOG_LINE_SIZE 128
+#define JSON_POOL_SIZE JSON_POOL_SIZE_FOR(2, 1024) // filtro + resposta (ver json_pool.h)
+#define SUPABASE_PAYLOAD_SIZE 384
+#define SUPABASE_RESPONSE_MAX_SIZE 4096
+#define SUPABASE_RESPONSE_TIMEOUT_MS 5000
+#define SUPABASE_JSON_NESTING_LIMIT 4
+#define TELEMETRY_FAST_INTERVAL_MS 10000
+#define TELEMETRY_RAMP_WINDOW_MS 300000
+#define TELEMETRY_GRAVITY_DEADBAND 0.001
+#define TELEMETRY_MIN_HEARTBEAT_S 60
+#define TELEMETRY_MIN_CONTROL_S 30
+#define MQTT_MESSAGE_MAX_SIZE 512
+#define MQTT_JSON_POOL_SIZE JSON_POOL_SIZE_FOR(2, MQTT_MESSAGE_MAX_SIZE + 256) // filtro + mensagem
+#define MQTT_TELEMETRY_SIZE 96
+#define MQTT_KEEPALIVE_S 30
+#define MQTT_CONNECT_TIMEOUT_MS 5000
+#define MQTT_RECONNECT_INTERVAL_MS 10000
+#define TRACE_BUFFER_SIZE 512
+#define TRACE_PARTITION_SUBTYPE 0x40
+#define API_CACHE_SIZE 1024
+#define API_JSON_POOL_SIZE JSON_POOL_SIZE_FOR(1, 1024) // resposta com os hidrômetros
+#define API_MAX_CONCORRENTES 2
+#define API_TAXA_POR_SEGUNDO 4.0
+#define API_RAJADA 8.0
+#define API_LOG_REJEICOES_A_CADA 50
+#define READING_TEMP_RESOLUTION 0.0625 // DS18B20 em 12 bits
+#define READING_GRAVITY_RESOLUTION 0.0001
+#define HYDROMETER_UDP_PORT 9501
+#define HYDROMETER_MAX_SOURCES 4
+#define HYDROMETER_DEDUPE_MS 5000
+#define HYDROMETER_STALE_MS 1800000
 
 extern const char *SUPABASE_URL;
 extern const char *SUPABASE_ANON_KEY;
@@ -32,6 +63,16 @@ extern float savedTemperaturaMinSeguranca;
 extern float savedTemperaturaMaxSeguranca;
 extern float savedTemperaturaAlvoLocal;
 extern float savedVariacaoTemperaturaLocal;
+extern float savedTelemetriaDeadband;
+extern unsigned long savedTelemetriaHeartbeatS;
+extern float savedTelemetriaRampa;
+extern unsigned long savedTelemetriaControleS;
+extern String savedTransporte;
+extern uint8_t savedHidrometroUnidade;
+extern String savedMqttHost;
+extern uint16_t savedMqttPort;
+extern String savedMqttUsuario;
+extern String savedMqttSenha;
 extern bool wifiConnected;
 extern bool apModeActive;
 extern bool processFound;
@@ -40,7 +81,7 @@ extern const int MAX_WIFI_ERRORS;
 extern bool currentRelayAquecimentoState;
 extern bool currentRelayResfriamentoState;
 extern bool currentRelayDegeloState;
-extern String logs[MAX_LOGS];
+extern char logs[MAX_LOGS][LOG_LINE_SIZE];
 extern int currentLogIndex;
 extern bool logBufferFull;
 extern unsigned long lastSensorReadTime;
@@ -2,10 +2,15 @@
 #define CONTROLE_H
 
 #include <DallasTemperature.h>
+#include "controle_logica.h"
+#include "trace_format.h"
 
 void setRelayState(int relayPin, bool state);
+void applyRelayCommand(bool aquecimento, bool resfriamento, bool degelo, const char *origem, const char *acao);
+void applyCloudCommand(TraceOrigem origem, const char *nomeOrigem, const CloudCommand &comando, const char *acao);
 float readDSTemperature(DeviceAddress sensorAddress, DallasTemperature &sensorInstance);
 void debugAllSensors();
+ControlParams getControlParams();
 void localControlLogic(float tempFermentador, float tempAmbiente, float tempDegelo);
 
 #endif // CONTROLE_H 
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef CONTROLE_LOGICA_H
+#define CONTROLE_LOGICA_H
+
+struct ControlParams {
+    bool degeloPorTemperatura;
+    float degeloTemperatura;
+    float temperaturaMinSeguranca;
+    float temperaturaMaxSeguranca;
+    float temperaturaAlvo;
+    float variacaoTemperatura;
+};
+
+struct ControlDecision {
+    bool aquecimento;
+    bool resfriamento;
+    bool degelo;
+    const char *acao;
+};
+
+struct CloudCommand {
+    bool aquecimento;
+    bool resfriamento;
+    bool degelo;
+};
+
+ControlDecision decideLocalControl(const ControlParams &params, float tempFermentador, float tempAmbiente, float tempDegelo);
+
+#endif // CONTROLE_LOGICA_H
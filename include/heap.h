@@ -0,0 +1,22 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <Arduino.h>
+
+struct HeapStatus {
+    uint32_t livre;
+    uint32_t minimoLivre;
+    uint32_t maiorBlocoLivre;
+    float fragmentacao;
+};
+
+HeapStatus getHeapStatus();
+void logHeapStatus();
+
+#ifdef ZERO_HEAP_MODE
+void beginCycleAllocationCount();
+uint32_t endCycleAllocationCount();
+uint32_t getLastCycleAllocations();
+#endif
+
+#endif // HEAP_H
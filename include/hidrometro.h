@@ -0,0 +1,38 @@
+#ifndef HIDROMETRO_H
+#define HIDROMETRO_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "hidrometro_parser.h"
+
+struct HydrometerSource {
+    uint32_t id;
+    char nome[24];
+    float gravidade;
+    float angulo;
+    float temperatura;
+    float bateria;
+    unsigned long ultimaLeituraMs;
+    bool ativo;
+    uint32_t recebidos;
+    uint32_t duplicados;
+};
+
+struct HydrometerStats {
+    uint32_t aceitos;
+    uint32_t duplicados;
+    uint32_t invalidos;
+    uint32_t semEspaco;
+    uint32_t versao;
+};
+
+extern HydrometerStats hydrometerStats;
+
+bool ingestHydrometerPacket(const char *data, size_t length, const char *origem);
+void beginHydrometerListener();
+float getHydrometerGravity();
+size_t getHydrometerSources(HydrometerSource *sources, size_t maxSources);
+void handlePostHydrometer(AsyncWebServerRequest *request);
+void handleHydrometerBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total);
+
+#endif // HIDROMETRO_H
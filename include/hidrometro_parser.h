@@ -0,0 +1,35 @@
+#ifndef HIDROMETRO_PARSER_H
+#define HIDROMETRO_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "json_pool.h"
+
+#define HYDROMETER_MAX_PACKET_SIZE 512
+#define HYDROMETER_JSON_POOL_SIZE JSON_POOL_SIZE_FOR(2, HYDROMETER_MAX_PACKET_SIZE + 256) // filtro + pacote
+
+enum HydrometerGravityUnit : uint8_t {
+    HIDROMETRO_SG,
+    HIDROMETRO_PLATO
+};
+
+struct HydrometerPacket {
+    uint32_t id;
+    char nome[24];
+    float gravidade;
+    float angulo;
+    float temperatura;
+    float bateria;
+};
+
+bool parseHydrometerGravityUnit(const char *text, HydrometerGravityUnit &unit);
+const char *getHydrometerGravityUnitString(HydrometerGravityUnit unit);
+
+// Valida um pacote JSON no estilo iSpindel e converte para SG e °C.
+// A gravidade é interpretada em unidadePadrao, a menos que o pacote
+// traga "gravity_unit". pool precisa estar vazio e ter ao menos
+// HYDROMETER_JSON_POOL_SIZE bytes; ele é liberado antes do retorno.
+bool parseHydrometerPacket(const char *data, size_t length, HydrometerGravityUnit unidadePadrao, JsonPoolAllocator &pool,
+                           HydrometerPacket &packet);
+
+#endif // HIDROMETRO_PARSER_H
@@ -0,0 +1,40 @@
+#ifndef JSON_POOL_H
+#define JSON_POOL_H
+
+#include <ArduinoJson.h>
+
+// Cada JsonDocument reserva um pool inteiro de slots na primeira alocação:
+// ARDUINOJSON_POOL_CAPACITY slots de dois ponteiros (1 KB no ESP32, 4 KB em
+// hosts de 64 bits), mais o cabeçalho de bloco da arena. As arenas são
+// dimensionadas por documento vivo ao mesmo tempo, mais os bytes de texto.
+#define JSON_POOL_BLOCK_HEADER 8
+#define JSON_SLOT_POOL_BYTES (ARDUINOJSON_POOL_CAPACITY * 2 * sizeof(void *) + JSON_POOL_BLOCK_HEADER)
+#define JSON_POOL_SIZE_FOR(documentos, textoBytes) ((documentos) * JSON_SLOT_POOL_BYTES + (textoBytes))
+
+class JsonPoolAllocator : public ArduinoJson::Allocator {
+public:
+    JsonPoolAllocator(uint8_t *buffer, size_t capacity);
+    void *allocate(size_t size) override;
+    void deallocate(void *pointer) override;
+    void *reallocate(void *pointer, size_t newSize) override;
+    size_t used() const { return usedBytes; }
+    size_t peak() const { return peakBytes; }
+    size_t capacity() const { return capacityBytes; }
+    uint32_t failures() const { return failedAllocations; }
+
+private:
+    uint8_t *buffer;
+    size_t capacityBytes;
+    size_t usedBytes;
+    size_t peakBytes;
+    size_t lastBlockOffset;
+    size_t liveBlocks;
+    uint32_t failedAllocations;
+};
+
+extern JsonPoolAllocator supabaseJsonPool;
+extern JsonPoolAllocator mqttJsonPool;
+extern JsonPoolAllocator apiJsonPool;
+extern JsonPoolAllocator hydrometerJsonPool;
+
+#endif // JSON_POOL_H
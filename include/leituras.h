@@ -0,0 +1,20 @@
+#ifndef LEITURAS_H
+#define LEITURAS_H
+
+#include <Arduino.h>
+
+struct ReadingSnapshot {
+    float tempFermentador;
+    float tempAmbiente;
+    float tempDegelo;
+    float gravidade;
+    bool releAquecimento;
+    bool releResfriamento;
+    bool releDegelo;
+    uint32_t versao;
+};
+
+void publishReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade);
+ReadingSnapshot getReadingSnapshot();
+
+#endif // LEITURAS_H
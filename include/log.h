@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 
-void addLog(String message);
+void addLog(const char *message);
+void addLog(const String &message);
+void addLogf(const char *format, ...) __attribute__((format(printf, 1, 2)));
 
-#endif // LOG_H 
\ No newline at end of file
+#endif // LOG_H
@@ -0,0 +1,19 @@
+#ifndef MQTT_H
+#define MQTT_H
+
+#include "transporte.h"
+
+class MqttTransport : public TelemetryTransport {
+public:
+    const char *name() const override { return "mqtt"; }
+    bool connected() override;
+    bool validateDevice() override;
+    bool getActiveProcess() override;
+    bool sendReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) override;
+    void loop() override;
+    bool pushesCommands() const override { return true; }
+};
+
+extern MqttTransport mqttTransport;
+
+#endif // MQTT_H
@@ -2,10 +2,24 @@
 #define SUPABASE_H
 
 #include <Arduino.h>
+#include <ArduinoJson.h>
+#include "transporte.h"
 
-String callSupabaseRpc(const String &rpcName, const String &payload);
+bool callSupabaseRpc(const char *rpcName, const char *payload, JsonDocument &filter, JsonDocument &responseDoc);
 bool validateDeviceOnSupabase();
 bool getActiveProcessOnSupabase();
-void controlFermenstationOnSupabase(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade = -1.0);
+bool controlFermenstationOnSupabase(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade = -1.0);
+
+class SupabaseTransport : public TelemetryTransport {
+public:
+    const char *name() const override { return "supabase"; }
+    bool connected() override;
+    bool validateDevice() override;
+    bool getActiveProcess() override;
+    bool sendReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) override;
+    void loop() override;
+};
+
+extern SupabaseTransport supabaseTransport;
 
 #endif // SUPABASE_H 
\ No newline at end of file
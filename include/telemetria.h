@@ -0,0 +1,39 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include <Arduino.h>
+
+enum TelemetryReason {
+    TELEMETRIA_SUPRIMIDA,
+    TELEMETRIA_PRIMEIRA,
+    TELEMETRIA_DEADBAND,
+    TELEMETRIA_RELE,
+    TELEMETRIA_CONTROLE,
+    TELEMETRIA_HEARTBEAT,
+    TELEMETRIA_RAMPA,
+    TELEMETRIA_ALARME,
+    TELEMETRIA_TOTAL_MOTIVOS
+};
+
+struct TelemetryStats {
+    uint32_t enviados;
+    uint32_t suprimidos;
+    uint32_t falhas;
+    uint32_t porMotivo[TELEMETRIA_TOTAL_MOTIVOS];
+};
+
+extern TelemetryStats telemetryStats;
+
+unsigned long getTelemetryInterval();
+// pollControl: o transporte só recebe comandos em resposta ao envio (Supabase),
+// então leituras suprimidas atrasariam o controle; envia ao menos a cada
+// savedTelemetriaControleS.
+TelemetryReason evaluateTelemetry(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade, bool pollControl);
+void markTelemetrySent(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade);
+void markTelemetryFailed();
+const char *getTelemetryReasonString(TelemetryReason reason);
+// Volta ao estado de boot: sem envio anterior, sem referência de rampa e
+// contadores zerados.
+void resetTelemetry();
+
+#endif // TELEMETRIA_H
@@ -0,0 +1,27 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include "trace_format.h"
+
+struct TraceStats {
+    uint32_t gravados;
+    uint32_t descartados;
+    uint32_t sequencia;
+    uint32_t setorAtual;
+    bool ativo;
+};
+
+extern TraceStats traceStats;
+
+void traceBegin();
+void traceFlush();
+void traceReading(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade);
+void traceWifiEvent(int evento);
+void traceResponse(TraceOrigem origem, bool ok, bool aquecimento, bool resfriamento, bool degelo);
+void traceConfig();
+void traceDecision(TraceOrigem origem, bool aquecimento, bool resfriamento, bool degelo);
+size_t traceStorageSize();
+bool traceReadRaw(size_t offset, uint8_t *buffer, size_t length);
+
+#endif // TRACE_H
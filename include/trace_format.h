@@ -0,0 +1,71 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+
+#define TRACE_MAGIC 0x52545346
+#define TRACE_SECTOR_SIZE 4096
+
+#define TRACE_RELE_AQUECIMENTO 0x01
+#define TRACE_RELE_RESFRIAMENTO 0x02
+#define TRACE_RELE_DEGELO 0x04
+#define TRACE_RESPOSTA_OK 0x80
+
+enum TraceRecordType : uint8_t {
+    TRACE_BOOT = 1,
+    TRACE_LEITURA = 2,
+    TRACE_WIFI = 3,
+    TRACE_RESPOSTA = 4,
+    TRACE_CONFIG = 5,
+    TRACE_DECISAO = 6,
+    TRACE_VAZIO = 0xFF
+};
+
+enum TraceOrigem : uint8_t {
+    TRACE_ORIGEM_LOCAL = 0,
+    TRACE_ORIGEM_SUPABASE = 1,
+    TRACE_ORIGEM_MQTT = 2
+};
+
+struct __attribute__((packed)) TraceSectorHeader {
+    uint32_t magic;
+    uint32_t sequencia;
+};
+
+struct __attribute__((packed)) TraceRecordHeader {
+    uint8_t tipo;
+    uint8_t tamanho;
+    uint32_t tempoMs;
+};
+
+struct __attribute__((packed)) TraceLeitura {
+    float tempFermentador;
+    float tempAmbiente;
+    float tempDegelo;
+    float gravidade;
+};
+
+struct __attribute__((packed)) TraceWifi {
+    int32_t evento;
+};
+
+struct __attribute__((packed)) TraceResposta {
+    uint8_t origem;
+    uint8_t flags;
+};
+
+struct __attribute__((packed)) TraceConfig {
+    uint8_t degeloPorTemperatura;
+    float degeloTemperatura;
+    float temperaturaMinSeguranca;
+    float temperaturaMaxSeguranca;
+    float temperaturaAlvo;
+    float variacaoTemperatura;
+};
+
+struct __attribute__((packed)) TraceDecisao {
+    uint8_t origem;
+    uint8_t reles;
+};
+
+#endif // TRACE_FORMAT_H
@@ -0,0 +1,27 @@
+#ifndef TRANSPORTE_H
+#define TRANSPORTE_H
+
+#include <ArduinoJson.h>
+
+class TelemetryTransport {
+public:
+    virtual ~TelemetryTransport() {}
+    virtual const char *name() const = 0;
+    virtual bool connected() = 0;
+    virtual bool validateDevice() = 0;
+    virtual bool getActiveProcess() = 0;
+    virtual bool sendReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) = 0;
+    virtual void loop() = 0;
+    // true quando o backend envia comandos sem depender de uma leitura (MQTT).
+    virtual bool pushesCommands() const { return false; }
+};
+
+extern TelemetryTransport *telemetryTransport;
+
+void selectTelemetryTransport();
+
+// Copia o process_id recebido do backend, aceitando texto ou inteiro.
+// Retorna false quando o id falta, está vazio ou não cabe em destino.
+bool readProcessId(JsonVariantConst valor, char *destino, size_t tamanho);
+
+#endif // TRANSPORTE_H
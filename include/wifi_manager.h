@@ -5,7 +5,7 @@
 void startAPMode();
 void connectToWiFi();
 void checkWiFiConnection();
-String getWiFiStatusString(int status);
+const char *getWiFiStatusString(int status);
 void scanNetworks();
 
 #endif // WIFI_MANAGER_H 
\ No newline at end of file
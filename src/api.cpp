@@ -2,16 +2,29 @@
 #include "config.h"
 #include "log.h"
 #include "storage.h"
-#include "controle.h"
-#include "sensores.h"
+#include "heap.h"
+#include "json_pool.h"
+#include "telemetria.h"
+#include "transporte.h"
+#include "trace.h"
+#include "api_cache.h"
+#include "leituras.h"
+#include "hidrometro.h"
 #include <ArduinoJson.h>
 #include <ESPAsyncWebServer.h>
 
 extern AsyncWebServer server;
 
-void handleGetConfig(AsyncWebServerRequest *request) {
-    addLog("GET /api/config solicitado");
-    JsonDocument doc;
+static EndpointGuard configGuard = {"/api/config", API_MAX_CONCORRENTES, API_TAXA_POR_SEGUNDO, API_RAJADA};
+static EndpointGuard logsGuard = {"/api/logs", API_MAX_CONCORRENTES, API_TAXA_POR_SEGUNDO, API_RAJADA};
+static EndpointGuard readingsGuard = {"/api/readings", API_MAX_CONCORRENTES, API_TAXA_POR_SEGUNDO, API_RAJADA};
+static EndpointGuard statusGuard = {"/api/status", API_MAX_CONCORRENTES, API_TAXA_POR_SEGUNDO, API_RAJADA};
+static EndpointGuard traceGuard = {"/api/trace", 1, 0.1, 1.0};
+static EndpointGuard hydrometerGuard = {"/api/hidrometro", API_MAX_CONCORRENTES, API_TAXA_POR_SEGUNDO, API_RAJADA};
+static CachedResponse configCache;
+static CachedResponse readingsCache;
+
+static void buildConfigJson(JsonDocument &doc) {
     doc["ssid"] = savedSsid;
     doc["deviceId"] = savedDeviceId;
     doc["processId"] = savedProcessId;
@@ -22,61 +35,189 @@ void handleGetConfig(AsyncWebServerRequest *request) {
     doc["temperaturaMaxSeguranca"] = savedTemperaturaMaxSeguranca;
     doc["temperaturaAlvoLocal"] = savedTemperaturaAlvoLocal;
     doc["variacaoTemperaturaLocal"] = savedVariacaoTemperaturaLocal;
-    String response;
-    serializeJson(doc, response);
-    request->send(200, "application/json", response);
-    addLog("Configurações enviadas com sucesso");
+    doc["telemetriaDeadband"] = savedTelemetriaDeadband;
+    doc["telemetriaHeartbeatS"] = savedTelemetriaHeartbeatS;
+    doc["telemetriaRampa"] = savedTelemetriaRampa;
+    doc["telemetriaControleS"] = savedTelemetriaControleS;
+    doc["transporte"] = savedTransporte;
+    doc["hidrometroUnidade"] = getHydrometerGravityUnitString((HydrometerGravityUnit)savedHidrometroUnidade);
+    doc["mqttHost"] = savedMqttHost;
+    doc["mqttPort"] = savedMqttPort;
+    doc["mqttUsuario"] = savedMqttUsuario;
+}
+
+static bool validateConfigJson(JsonDocument &doc, char *erro, size_t tamanho) {
+    JsonVariant deadband = doc["telemetriaDeadband"];
+    if (!deadband.isNull() && (!deadband.is<float>() || !(deadband.as<float>() >= 0.0))) {
+        snprintf(erro, tamanho, "telemetriaDeadband deve ser um número >= 0");
+        return false;
+    }
+    JsonVariant heartbeat = doc["telemetriaHeartbeatS"];
+    if (!heartbeat.isNull() && (!heartbeat.is<unsigned long>() || heartbeat.as<unsigned long>() < TELEMETRY_MIN_HEARTBEAT_S)) {
+        snprintf(erro, tamanho, "telemetriaHeartbeatS deve ser um inteiro >= %d", TELEMETRY_MIN_HEARTBEAT_S);
+        return false;
+    }
+    JsonVariant controle = doc["telemetriaControleS"];
+    if (!controle.isNull() && (!controle.is<unsigned long>() || controle.as<unsigned long>() < TELEMETRY_MIN_CONTROL_S)) {
+        snprintf(erro, tamanho, "telemetriaControleS deve ser um inteiro >= %d", TELEMETRY_MIN_CONTROL_S);
+        return false;
+    }
+    JsonVariant rampa = doc["telemetriaRampa"];
+    if (!rampa.isNull() && (!rampa.is<float>() || !(rampa.as<float>() > 0.0))) {
+        snprintf(erro, tamanho, "telemetriaRampa deve ser um número > 0");
+        return false;
+    }
+    HydrometerGravityUnit unidade;
+    if (!doc["hidrometroUnidade"].isNull() && !parseHydrometerGravityUnit(doc["hidrometroUnidade"].as<const char *>(), unidade)) {
+        snprintf(erro, tamanho, "hidrometroUnidade deve ser SG ou P");
+        return false;
+    }
+    return true;
+}
+
+void handleGetConfig(AsyncWebServerRequest *request) {
+    if (!admitRequest(request, configGuard)) {
+        return;
+    }
+    sendCachedJson(request, configGuard, configCache, configVersion, buildConfigJson);
 }
 
 void handleGetLogs(AsyncWebServerRequest *request) {
-    addLog("GET /api/logs solicitado");
+    if (!admitRequest(request, logsGuard)) {
+        return;
+    }
     JsonDocument doc;
     JsonArray logArray = doc.to<JsonArray>();
     if (logBufferFull) {
         for (int i = currentLogIndex; i < MAX_LOGS; i++) {
-            logArray.add(logs[i]);
+            logArray.add((const char *)logs[i]);
         }
         for (int i = 0; i < currentLogIndex; i++) {
-            logArray.add(logs[i]);
+            logArray.add((const char *)logs[i]);
         }
     } else {
         for (int i = 0; i < currentLogIndex; i++) {
-            logArray.add(logs[i]);
+            logArray.add((const char *)logs[i]);
         }
     }
     String response;
     serializeJson(logArray, response);
     request->send(200, "application/json", response);
-    addLog("Logs enviados com sucesso");
+}
+
+static void buildReadingsJson(JsonDocument &doc) {
+    ReadingSnapshot snapshot = getReadingSnapshot();
+    doc["tempFermentador"] = snapshot.tempFermentador;
+    doc["tempAmbiente"] = snapshot.tempAmbiente;
+    doc["tempDegelo"] = snapshot.tempDegelo;
+    doc["releAquecimento"] = snapshot.releAquecimento;
+    doc["releResfriamento"] = snapshot.releResfriamento;
+    doc["releDegelo"] = snapshot.releDegelo;
+    doc["gravidade"] = snapshot.gravidade;
+    HydrometerSource sources[HYDROMETER_MAX_SOURCES];
+    size_t count = getHydrometerSources(sources, HYDROMETER_MAX_SOURCES);
+    JsonArray hidrometros = doc["hidrometros"].to<JsonArray>();
+    for (size_t i = 0; i < count; i++) {
+        JsonObject hidrometro = hidrometros.add<JsonObject>();
+        hidrometro["id"] = sources[i].id;
+        hidrometro["nome"] = (const char *)sources[i].nome;
+        hidrometro["gravidade"] = sources[i].gravidade;
+        hidrometro["angulo"] = sources[i].angulo;
+        hidrometro["temperatura"] = sources[i].temperatura;
+        hidrometro["bateria"] = sources[i].bateria;
+        hidrometro["ultimaLeituraMs"] = sources[i].ultimaLeituraMs;
+        hidrometro["ativo"] = sources[i].ativo;
+    }
 }
 
 void handleGetCurrentReadings(AsyncWebServerRequest *request) {
-    addLog("GET /api/readings solicitado");
-    float tempFermentador = readDSTemperature(tempFermentadorAddress, sensorFermentador);
-    float tempAmbiente = readDSTemperature(tempAmbienteAddress, sensorAmbiente);
-    float tempDegelo = readDSTemperature(tempDegeloAddress, sensorDegelo);
+    if (!admitRequest(request, readingsGuard)) {
+        return;
+    }
+    sendCachedJson(request, readingsGuard, readingsCache, getReadingSnapshot().versao + hydrometerStats.versao, buildReadingsJson);
+}
+
+void handleGetStatus(AsyncWebServerRequest *request) {
+    if (!admitRequest(request, statusGuard)) {
+        return;
+    }
+    HeapStatus heap = getHeapStatus();
     JsonDocument doc;
-    doc["tempFermentador"] = tempFermentador;
-    doc["tempAmbiente"] = tempAmbiente;
-    doc["tempDegelo"] = tempDegelo;
-    doc["releAquecimento"] = currentRelayAquecimentoState;
-    doc["releResfriamento"] = currentRelayResfriamentoState;
-    doc["releDegelo"] = currentRelayDegeloState;
+    doc["uptimeMs"] = millis();
+    doc["heapLivre"] = heap.livre;
+    doc["heapMinimoLivre"] = heap.minimoLivre;
+    doc["heapMaiorBlocoLivre"] = heap.maiorBlocoLivre;
+    doc["heapFragmentacao"] = heap.fragmentacao;
+#ifdef ZERO_HEAP_MODE
+    doc["alocacoesCiclo"] = getLastCycleAllocations();
+#endif
+    doc["transporte"] = telemetryTransport->name();
+    doc["transporteConectado"] = telemetryTransport->connected();
+    doc["jsonPoolPico"] = supabaseJsonPool.peak();
+    doc["jsonPoolCapacidade"] = supabaseJsonPool.capacity();
+    doc["jsonPoolFalhas"] = supabaseJsonPool.failures() + mqttJsonPool.failures() + apiJsonPool.failures() +
+                           hydrometerJsonPool.failures();
+    JsonObject telemetria = doc["telemetria"].to<JsonObject>();
+    telemetria["enviados"] = telemetryStats.enviados;
+    telemetria["suprimidos"] = telemetryStats.suprimidos;
+    telemetria["falhas"] = telemetryStats.falhas;
+    telemetria["intervaloMs"] = getTelemetryInterval();
+    JsonObject motivos = telemetria["motivos"].to<JsonObject>();
+    for (int i = TELEMETRIA_PRIMEIRA; i < TELEMETRIA_TOTAL_MOTIVOS; i++) {
+        motivos[getTelemetryReasonString((TelemetryReason)i)] = telemetryStats.porMotivo[i];
+    }
+    JsonObject trace = doc["trace"].to<JsonObject>();
+    trace["ativo"] = traceStats.ativo;
+    trace["gravados"] = traceStats.gravados;
+    trace["descartados"] = traceStats.descartados;
+    trace["sequencia"] = traceStats.sequencia;
+    JsonObject hidrometros = doc["hidrometros"].to<JsonObject>();
+    hidrometros["aceitos"] = hydrometerStats.aceitos;
+    hidrometros["duplicados"] = hydrometerStats.duplicados;
+    hidrometros["invalidos"] = hydrometerStats.invalidos;
+    hidrometros["semEspaco"] = hydrometerStats.semEspaco;
+    JsonObject api = doc["api"].to<JsonObject>();
+    EndpointGuard *guards[] = {&configGuard, &logsGuard, &readingsGuard, &statusGuard, &traceGuard, &hydrometerGuard};
+    for (EndpointGuard *guard : guards) {
+        JsonObject endpoint = api[guard->nome].to<JsonObject>();
+        endpoint["aceitas"] = guard->aceitas;
+        endpoint["naoModificadas"] = guard->naoModificadas;
+        endpoint["rejeitadas"] = guard->rejeitadas;
+        endpoint["emAndamento"] = guard->emAndamento;
+    }
     String response;
     serializeJson(doc, response);
     request->send(200, "application/json", response);
-    addLog("Leituras enviadas com sucesso");
+}
+
+void handleGetTrace(AsyncWebServerRequest *request) {
+    if (!admitRequest(request, traceGuard)) {
+        return;
+    }
+    addLog("GET /api/trace solicitado");
+    size_t total = traceStorageSize();
+    if (total == 0) {
+        request->send(404, "text/plain", "Trace indisponível");
+        return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", total, [](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        size_t length = min(maxLen, traceStorageSize() - index);
+        return traceReadRaw(index, buffer, length) ? length : 0;
+    });
+    response->addHeader("Content-Disposition", "attachment; filename=fermenstation.trace");
+    request->send(response);
 }
 
 void handleSaveConfig(AsyncWebServerRequest *request) {
     addLog("POST /api/config recebido");
     if (request->hasHeader("Content-Type")) {
         String contentType = request->getHeader("Content-Type")->value();
-        addLog("Content-Type recebido: " + contentType);
+        addLogf("Content-Type recebido: %s", contentType.c_str());
         if (contentType.indexOf("application/json") != -1) {
             if (request->_tempObject != NULL) {
-                String body = *((String *)(request->_tempObject));
-                addLog("Body recebido: " + body);
+                // O corpo traz password e mqttSenha e /api/logs é público: registra só o tamanho.
+                const String &body = *((String *)(request->_tempObject));
+                addLogf("Corpo recebido: %u bytes", (unsigned)body.length());
                 JsonDocument doc;
                 DeserializationError error = deserializeJson(doc, body);
                 if (error) {
@@ -86,6 +227,13 @@ void handleSaveConfig(AsyncWebServerRequest *request) {
                     delete (String *)(request->_tempObject);
                     return;
                 }
+                char erro[96];
+                if (!validateConfigJson(doc, erro, sizeof(erro))) {
+                    addLogf("Configuração rejeitada: %s", erro);
+                    request->send(400, "text/plain", erro);
+                    delete (String *)(request->_tempObject);
+                    return;
+                }
                 if (doc["ssid"].is<String>()) savedSsid = doc["ssid"].as<String>();
                 if (doc["password"].is<String>()) savedPassword = doc["password"].as<String>();
                 if (doc["deviceId"].is<String>()) savedDeviceId = doc["deviceId"].as<String>();
@@ -96,6 +244,17 @@ void handleSaveConfig(AsyncWebServerRequest *request) {
                 if (doc["temperaturaMaxSeguranca"].is<float>()) savedTemperaturaMaxSeguranca = doc["temperaturaMaxSeguranca"].as<float>();
                 if (doc["temperaturaAlvoLocal"].is<float>()) savedTemperaturaAlvoLocal = doc["temperaturaAlvoLocal"].as<float>();
                 if (doc["variacaoTemperaturaLocal"].is<float>()) savedVariacaoTemperaturaLocal = doc["variacaoTemperaturaLocal"].as<float>();
+                if (doc["telemetriaDeadband"].is<float>()) savedTelemetriaDeadband = doc["telemetriaDeadband"].as<float>();
+                if (doc["telemetriaHeartbeatS"].is<unsigned long>()) savedTelemetriaHeartbeatS = doc["telemetriaHeartbeatS"].as<unsigned long>();
+                if (doc["telemetriaRampa"].is<float>()) savedTelemetriaRampa = doc["telemetriaRampa"].as<float>();
+                if (doc["telemetriaControleS"].is<unsigned long>()) savedTelemetriaControleS = doc["telemetriaControleS"].as<unsigned long>();
+                if (doc["transporte"].is<String>()) savedTransporte = doc["transporte"].as<String>();
+                if (doc["mqttHost"].is<String>()) savedMqttHost = doc["mqttHost"].as<String>();
+                if (doc["mqttPort"].is<uint16_t>()) savedMqttPort = doc["mqttPort"].as<uint16_t>();
+                if (doc["mqttUsuario"].is<String>()) savedMqttUsuario = doc["mqttUsuario"].as<String>();
+                if (doc["mqttSenha"].is<String>()) savedMqttSenha = doc["mqttSenha"].as<String>();
+                HydrometerGravityUnit hidrometroUnidade;
+                if (parseHydrometerGravityUnit(doc["hidrometroUnidade"] | "", hidrometroUnidade)) savedHidrometroUnidade = hidrometroUnidade;
                 saveConfigurations();
                 request->send(200, "application/json", "{\"status\":\"success\", \"message\":\"Configurações salvas com sucesso\"}");
                 addLog("Configurações salvas via POST");
@@ -149,12 +308,31 @@ void setupAPIEndpoints() {
     server.on("/api/config", HTTP_GET, [](AsyncWebServerRequest *request) { handleGetConfig(request); });
     server.on("/api/logs", HTTP_GET, [](AsyncWebServerRequest *request) { handleGetLogs(request); });
     server.on("/api/readings", HTTP_GET, [](AsyncWebServerRequest *request) { handleGetCurrentReadings(request); });
+    server.on("/api/status", HTTP_GET, [](AsyncWebServerRequest *request) { handleGetStatus(request); });
+    server.on("/api/trace", HTTP_GET, [](AsyncWebServerRequest *request) { handleGetTrace(request); });
     server.on("/api/config", HTTP_POST, [](AsyncWebServerRequest *request) { handleSaveConfig(request); }, NULL, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
         if(request->_tempObject == NULL){
             request->_tempObject = new String();
         }
         ((String*)(request->_tempObject))->concat((const char*)data, len);
     });
+    // Com corpo aceitável, a admissão acontece no primeiro fragmento, antes do
+    // malloc; se ela (ou o malloc) falhou, a resposta já foi enviada.
+    server.on("/api/hidrometro", HTTP_POST, [](AsyncWebServerRequest *request) {
+        size_t length = request->contentLength();
+        if (length > 0 && length <= HYDROMETER_MAX_PACKET_SIZE) {
+            if (request->_tempObject != NULL) {
+                handlePostHydrometer(request);
+            }
+        } else if (admitRequest(request, hydrometerGuard)) {
+            handlePostHydrometer(request);
+        }
+    }, NULL, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+        if (index == 0 && total <= HYDROMETER_MAX_PACKET_SIZE && !admitRequest(request, hydrometerGuard)) {
+            return;
+        }
+        handleHydrometerBody(request, data, len, index, total);
+    });
     server.on("/api/reset", HTTP_POST, [](AsyncWebServerRequest *request) { handleResetConfig(request); });
     server.on("/api/restart", HTTP_POST, [](AsyncWebServerRequest *request) { handleRestartDevice(request); });
     server.onNotFound([](AsyncWebServerRequest *request) { handleNotFound(request); });
@@ -0,0 +1,82 @@
+#include "api_cache.h"
+#include "json_pool.h"
+#include "log.h"
+
+volatile uint32_t configVersion = 1;
+
+static uint8_t apiJsonBuffer[API_JSON_POOL_SIZE] __attribute__((aligned(8)));
+JsonPoolAllocator apiJsonPool(apiJsonBuffer, sizeof(apiJsonBuffer));
+
+static uint32_t bootId = 0;
+
+void bumpConfigVersion() {
+    configVersion++;
+}
+
+bool admitRequest(AsyncWebServerRequest *request, EndpointGuard &guard) {
+    unsigned long now = millis();
+    if (guard.ultimaRecarga == 0) {
+        guard.tokens = guard.rajada;
+    } else {
+        guard.tokens = min(guard.rajada, guard.tokens + (now - guard.ultimaRecarga) * guard.taxaPorSegundo / 1000.0f);
+    }
+    guard.ultimaRecarga = now;
+    if (guard.emAndamento >= guard.maxConcorrentes || guard.tokens < 1.0f) {
+        guard.rejeitadas++;
+        if (guard.rejeitadas % API_LOG_REJEICOES_A_CADA == 1) {
+            addLogf("%s sobrecarregado: %u requisições rejeitadas", guard.nome, (unsigned)guard.rejeitadas);
+        }
+        AsyncWebServerResponse *response = request->beginResponse(429, "text/plain", "Muitas requisições");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return false;
+    }
+    guard.tokens -= 1.0f;
+    guard.emAndamento++;
+    guard.aceitas++;
+    EndpointGuard *guardPtr = &guard;
+    request->onDisconnect([guardPtr]() {
+        if (guardPtr->emAndamento > 0)
+            guardPtr->emAndamento--;
+    });
+    return true;
+}
+
+static bool refreshCache(CachedResponse &cache, uint32_t versao, JsonBuilder build) {
+    if (cache.valido && cache.versao == versao) {
+        return true;
+    }
+    if (bootId == 0) {
+        bootId = esp_random() | 1;
+    }
+    JsonDocument doc(&apiJsonPool);
+    build(doc);
+    size_t tamanho = measureJson(doc);
+    if (doc.overflowed() || tamanho >= sizeof(cache.corpo)) {
+        addLogf("Resposta de %u bytes não cabe no cache da API", (unsigned)tamanho);
+        cache.valido = false;
+        return false;
+    }
+    cache.tamanho = serializeJson(doc, cache.corpo, sizeof(cache.corpo));
+    cache.versao = versao;
+    snprintf(cache.etag, sizeof(cache.etag), "\"%08x-%x\"", (unsigned)bootId, (unsigned)versao);
+    cache.valido = true;
+    return true;
+}
+
+void sendCachedJson(AsyncWebServerRequest *request, EndpointGuard &guard, CachedResponse &cache, uint32_t versao, JsonBuilder build) {
+    if (!refreshCache(cache, versao, build)) {
+        request->send(500, "text/plain", "Resposta excede o cache da API");
+        return;
+    }
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") && strcmp(request->getHeader("If-None-Match")->value().c_str(), cache.etag) == 0) {
+        guard.naoModificadas++;
+        response = request->beginResponse(304);
+    } else {
+        response = request->beginResponse(200, "application/json", cache.corpo);
+    }
+    response->addHeader("ETag", cache.etag);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
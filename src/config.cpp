@@ -1,4 +1,5 @@
 #include "config.h"
+#include "hidrometro_parser.h"
 #include "secrets.h"
 // ... existing code ...
 
@@ -28,6 +29,16 @@ float savedTemperaturaMinSeguranca = 0.0;
 float savedTemperaturaMaxSeguranca = 35.0;
 float savedTemperaturaAlvoLocal = 20.0;
 float savedVariacaoTemperaturaLocal = 0.5;
+float savedTelemetriaDeadband = 0.2;
+unsigned long savedTelemetriaHeartbeatS = 600;
+float savedTelemetriaRampa = 1.0;
+unsigned long savedTelemetriaControleS = 120;
+String savedTransporte = "supabase";
+uint8_t savedHidrometroUnidade = HIDROMETRO_SG;
+String savedMqttHost = "";
+uint16_t savedMqttPort = 1883;
+String savedMqttUsuario = "";
+String savedMqttSenha = "";
 bool wifiConnected = false;
 bool apModeActive = false;
 bool processFound = false;
@@ -36,7 +47,7 @@ const int MAX_WIFI_ERRORS = 5;
 bool currentRelayAquecimentoState = false;
 bool currentRelayResfriamentoState = false;
 bool currentRelayDegeloState = false;
-String logs[MAX_LOGS];
+char logs[MAX_LOGS][LOG_LINE_SIZE];
 int currentLogIndex = 0;
 bool logBufferFull = false;
 unsigned long lastSensorReadTime = 0;
@@ -2,11 +2,29 @@
 #include "config.h"
 #include "sensores.h"
 #include "log.h"
+#include "trace.h"
 #include <DallasTemperature.h>
 
 void setRelayState(int relayPin, bool state) {
     digitalWrite(relayPin, state ? HIGH : LOW);
-    addLog("Relé " + String(relayPin) + " definido como " + (state ? "LIGADO" : "DESLIGADO"));
+    addLogf("Relé %d definido como %s", relayPin, state ? "LIGADO" : "DESLIGADO");
+}
+
+void applyRelayCommand(bool aquecimento, bool resfriamento, bool degelo, const char *origem, const char *acao) {
+    currentRelayAquecimentoState = aquecimento;
+    currentRelayResfriamentoState = resfriamento;
+    currentRelayDegeloState = degelo;
+    setRelayState(RELAY_PIN_AQUECIMENTO, currentRelayAquecimentoState);
+    setRelayState(RELAY_PIN_RESFRIAMENTO, currentRelayResfriamentoState);
+    setRelayState(RELAY_PIN_DEGELO, currentRelayDegeloState);
+    addLogf("Relés atualizados pelo %s: Aquecimento=%d, Resfriamento=%d, Degelo=%d",
+            origem, currentRelayAquecimentoState, currentRelayResfriamentoState, currentRelayDegeloState);
+    addLogf("Ação tomada pelo %s: %s", origem, acao);
+}
+
+void applyCloudCommand(TraceOrigem origem, const char *nomeOrigem, const CloudCommand &comando, const char *acao) {
+    traceDecision(origem, comando.aquecimento, comando.resfriamento, comando.degelo);
+    applyRelayCommand(comando.aquecimento, comando.resfriamento, comando.degelo, nomeOrigem, acao);
 }
 
 float readDSTemperature(DeviceAddress sensorAddress, DallasTemperature &sensorInstance) {
@@ -21,56 +39,33 @@ float readDSTemperature(DeviceAddress sensorAddress, DallasTemperature &sensorIn
 
 void debugAllSensors() {
     addLog("[DEBUG] Temperaturas:");
-    addLog("Fermentador: " + String(readDSTemperature(tempFermentadorAddress, sensorFermentador)) + "°C");
-    addLog("Ambiente: " + String(readDSTemperature(tempAmbienteAddress, sensorAmbiente)) + "°C");
-    addLog("Degelo: " + String(readDSTemperature(tempDegeloAddress, sensorDegelo)) + "°C");
+    addLogf("Fermentador: %.2f°C", readDSTemperature(tempFermentadorAddress, sensorFermentador));
+    addLogf("Ambiente: %.2f°C", readDSTemperature(tempAmbienteAddress, sensorAmbiente));
+    addLogf("Degelo: %.2f°C", readDSTemperature(tempDegeloAddress, sensorDegelo));
+}
+
+ControlParams getControlParams() {
+    ControlParams params;
+    params.degeloPorTemperatura = savedDegeloModo == "por_temperatura";
+    params.degeloTemperatura = savedDegeloTemperatura;
+    params.temperaturaMinSeguranca = savedTemperaturaMinSeguranca;
+    params.temperaturaMaxSeguranca = savedTemperaturaMaxSeguranca;
+    params.temperaturaAlvo = savedTemperaturaAlvoLocal;
+    params.variacaoTemperatura = savedVariacaoTemperaturaLocal;
+    return params;
 }
 
 void localControlLogic(float tempFermentador, float tempAmbiente, float tempDegelo) {
     addLog("Executando lógica de controle LOCAL (offline/fallback).");
-    currentRelayAquecimentoState = false;
-    currentRelayResfriamentoState = false;
-    currentRelayDegeloState = false;
-    String acaoLocal = "Nenhuma ação local necessária.";
-    if (savedDegeloModo == "por_temperatura") {
-        if (tempDegelo < savedDegeloTemperatura) {
-            currentRelayDegeloState = true;
-            acaoLocal = "Degelo por temperatura ativado (local).";
-        }
-    }
-    if (currentRelayDegeloState) {
-        currentRelayAquecimentoState = false;
-        currentRelayResfriamentoState = false;
-    } else {
-        if (tempFermentador < savedTemperaturaMinSeguranca) {
-            currentRelayAquecimentoState = true;
-            currentRelayResfriamentoState = false;
-            acaoLocal = "Aquecimento de SEGURANÇA (temp muito baixa - local).";
-        } else if (tempFermentador > savedTemperaturaMaxSeguranca) {
-            currentRelayAquecimentoState = false;
-            currentRelayResfriamentoState = true;
-            acaoLocal = "Resfriamento de SEGURANÇA (temp muito alta - local).";
-        } else {
-            if (tempFermentador < (savedTemperaturaAlvoLocal - savedVariacaoTemperaturaLocal)) {
-                currentRelayAquecimentoState = true;
-                currentRelayResfriamentoState = false;
-                acaoLocal = "Aquecimento (temp abaixo do alvo - local).";
-            } else if (tempFermentador > (savedTemperaturaAlvoLocal + savedVariacaoTemperaturaLocal)) {
-                currentRelayAquecimentoState = false;
-                currentRelayResfriamentoState = true;
-                acaoLocal = "Resfriamento (temp acima do alvo - local).";
-            } else {
-                currentRelayAquecimentoState = false;
-                currentRelayResfriamentoState = false;
-                acaoLocal = "Temperatura no alvo - relés desligados (local).";
-            }
-        }
-    }
+    ControlDecision decision = decideLocalControl(getControlParams(), tempFermentador, tempAmbiente, tempDegelo);
+    currentRelayAquecimentoState = decision.aquecimento;
+    currentRelayResfriamentoState = decision.resfriamento;
+    currentRelayDegeloState = decision.degelo;
+    traceDecision(TRACE_ORIGEM_LOCAL, decision.aquecimento, decision.resfriamento, decision.degelo);
     setRelayState(RELAY_PIN_AQUECIMENTO, currentRelayAquecimentoState);
     setRelayState(RELAY_PIN_RESFRIAMENTO, currentRelayResfriamentoState);
     setRelayState(RELAY_PIN_DEGELO, currentRelayDegeloState);
-    addLog("Relés atualizados LOCALMENTE: Aquecimento=" + String(currentRelayAquecimentoState) +
-           ", Resfriamento=" + String(currentRelayResfriamentoState) +
-           ", Degelo=" + String(currentRelayDegeloState));
-    addLog("Ação tomada localmente: " + acaoLocal);
-} 
\ No newline at end of file
+    addLogf("Relés atualizados LOCALMENTE: Aquecimento=%d, Resfriamento=%d, Degelo=%d",
+            currentRelayAquecimentoState, currentRelayResfriamentoState, currentRelayDegeloState);
+    addLogf("Ação tomada localmente: %s", decision.acao);
+}
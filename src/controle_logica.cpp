@@ -0,0 +1,41 @@
+#include "controle_logica.h"
+
+ControlDecision decideLocalControl(const ControlParams &params, float tempFermentador, float tempAmbiente, float tempDegelo) {
+    (void)tempAmbiente;
+    ControlDecision decision = {false, false, false, "Nenhuma ação local necessária."};
+    if (params.degeloPorTemperatura) {
+        if (tempDegelo < params.degeloTemperatura) {
+            decision.degelo = true;
+            decision.acao = "Degelo por temperatura ativado (local).";
+        }
+    }
+    if (decision.degelo) {
+        decision.aquecimento = false;
+        decision.resfriamento = false;
+    } else {
+        if (tempFermentador < params.temperaturaMinSeguranca) {
+            decision.aquecimento = true;
+            decision.resfriamento = false;
+            decision.acao = "Aquecimento de SEGURANÇA (temp muito baixa - local).";
+        } else if (tempFermentador > params.temperaturaMaxSeguranca) {
+            decision.aquecimento = false;
+            decision.resfriamento = true;
+            decision.acao = "Resfriamento de SEGURANÇA (temp muito alta - local).";
+        } else {
+            if (tempFermentador < (params.temperaturaAlvo - params.variacaoTemperatura)) {
+                decision.aquecimento = true;
+                decision.resfriamento = false;
+                decision.acao = "Aquecimento (temp abaixo do alvo - local).";
+            } else if (tempFermentador > (params.temperaturaAlvo + params.variacaoTemperatura)) {
+                decision.aquecimento = false;
+                decision.resfriamento = true;
+                decision.acao = "Resfriamento (temp acima do alvo - local).";
+            } else {
+                decision.aquecimento = false;
+                decision.resfriamento = false;
+                decision.acao = "Temperatura no alvo - relés desligados (local).";
+            }
+        }
+    }
+    return decision;
+}
@@ -0,0 +1,66 @@
+#include "heap.h"
+#include "log.h"
+#include <esp_heap_caps.h>
+
+HeapStatus getHeapStatus() {
+    HeapStatus status;
+    status.livre = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    status.minimoLivre = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    status.maiorBlocoLivre = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    status.fragmentacao = status.livre > 0 ? 100.0f * (1.0f - (float)status.maiorBlocoLivre / status.livre) : 0.0f;
+    return status;
+}
+
+void logHeapStatus() {
+    HeapStatus status = getHeapStatus();
+    addLogf("Heap: livre=%u, mínimo=%u, maior bloco=%u, fragmentação=%.1f%%",
+            (unsigned)status.livre, (unsigned)status.minimoLivre, (unsigned)status.maiorBlocoLivre, status.fragmentacao);
+}
+
+#ifdef ZERO_HEAP_MODE
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+static volatile TaskHandle_t countedTask = nullptr;
+static volatile uint32_t cycleAllocations = 0;
+static uint32_t lastCycleAllocations = 0;
+
+static void countAllocation() {
+    if (countedTask != nullptr && xTaskGetCurrentTaskHandle() == countedTask) {
+        cycleAllocations++;
+    }
+}
+
+void *__wrap_malloc(size_t size) {
+    countAllocation();
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    countAllocation();
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size) {
+    countAllocation();
+    return __real_realloc(pointer, size);
+}
+}
+
+void beginCycleAllocationCount() {
+    cycleAllocations = 0;
+    countedTask = xTaskGetCurrentTaskHandle();
+}
+
+uint32_t endCycleAllocationCount() {
+    countedTask = nullptr;
+    lastCycleAllocations = cycleAllocations;
+    return lastCycleAllocations;
+}
+
+uint32_t getLastCycleAllocations() {
+    return lastCycleAllocations;
+}
+#endif
@@ -0,0 +1,186 @@
+#include "hidrometro.h"
+#include "config.h"
+#include "log.h"
+#include <AsyncUDP.h>
+
+HydrometerStats hydrometerStats = {};
+
+static AsyncUDP hydrometerUdp;
+static HydrometerSource hydrometerSources[HYDROMETER_MAX_SOURCES];
+static portMUX_TYPE hydrometerMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Arena do parser, compartilhada pelas tasks async_udp e async_tcp. Fica fora
+// da pilha delas e é serializada por um mutex (o parse é longo demais para
+// um spinlock).
+static uint8_t hydrometerJsonBuffer[HYDROMETER_JSON_POOL_SIZE] __attribute__((aligned(8)));
+JsonPoolAllocator hydrometerJsonPool(hydrometerJsonBuffer, sizeof(hydrometerJsonBuffer));
+
+static SemaphoreHandle_t hydrometerParserMutex() {
+    static StaticSemaphore_t mutexBuffer;
+    static SemaphoreHandle_t mutex = xSemaphoreCreateMutexStatic(&mutexBuffer);
+    return mutex;
+}
+
+static bool sameSource(const HydrometerSource &source, const HydrometerPacket &packet) {
+    if (packet.id != 0) {
+        return source.id == packet.id;
+    }
+    return source.id == 0 && strcmp(source.nome, packet.nome) == 0;
+}
+
+static bool samePacket(const HydrometerSource &source, const HydrometerPacket &packet) {
+    return source.gravidade == packet.gravidade && (source.angulo == packet.angulo || (isnan(source.angulo) && isnan(packet.angulo))) &&
+           (source.temperatura == packet.temperatura || (isnan(source.temperatura) && isnan(packet.temperatura)));
+}
+
+bool ingestHydrometerPacket(const char *data, size_t length, const char *origem) {
+    HydrometerPacket packet;
+    xSemaphoreTake(hydrometerParserMutex(), portMAX_DELAY);
+    bool valido = parseHydrometerPacket(data, length, (HydrometerGravityUnit)savedHidrometroUnidade, hydrometerJsonPool, packet);
+    xSemaphoreGive(hydrometerParserMutex());
+    if (!valido) {
+        portENTER_CRITICAL(&hydrometerMux);
+        hydrometerStats.invalidos++;
+        portEXIT_CRITICAL(&hydrometerMux);
+        return false;
+    }
+    unsigned long now = millis();
+    int slot = -1;
+    int livre = -1;
+    bool duplicado = false;
+    bool novaFonte = false;
+    uint32_t semEspaco = 0;
+    portENTER_CRITICAL(&hydrometerMux);
+    for (int i = 0; i < HYDROMETER_MAX_SOURCES; i++) {
+        HydrometerSource &source = hydrometerSources[i];
+        if (source.recebidos > 0 && sameSource(source, packet)) {
+            slot = i;
+            break;
+        }
+        if (livre < 0 && (source.recebidos == 0 || !source.ativo)) {
+            livre = i;
+        }
+    }
+    if (slot >= 0 && samePacket(hydrometerSources[slot], packet) && now - hydrometerSources[slot].ultimaLeituraMs < HYDROMETER_DEDUPE_MS) {
+        hydrometerSources[slot].duplicados++;
+        hydrometerStats.duplicados++;
+        duplicado = true;
+    } else {
+        if (slot < 0 && livre >= 0) {
+            slot = livre;
+            hydrometerSources[slot] = {};
+            hydrometerSources[slot].id = packet.id;
+            memcpy(hydrometerSources[slot].nome, packet.nome, sizeof(hydrometerSources[slot].nome));
+        }
+        if (slot >= 0) {
+            HydrometerSource &source = hydrometerSources[slot];
+            novaFonte = !source.ativo;
+            source.gravidade = packet.gravidade;
+            source.angulo = packet.angulo;
+            source.temperatura = packet.temperatura;
+            source.bateria = packet.bateria;
+            source.ultimaLeituraMs = now;
+            source.ativo = true;
+            source.recebidos++;
+            hydrometerStats.aceitos++;
+            hydrometerStats.versao++;
+        } else {
+            semEspaco = ++hydrometerStats.semEspaco;
+        }
+    }
+    portEXIT_CRITICAL(&hydrometerMux);
+    // Leituras aceitas ficam só nos contadores de /api/status; o log registra
+    // a primeira leitura de cada fonte (nova ou reativada) para não encher o anel.
+    if (slot < 0) {
+        if (semEspaco % API_LOG_REJEICOES_A_CADA == 1) {
+            addLogf("Hidrômetro %s ignorado (%s): limite de %d fontes (%u pacotes)", packet.nome, origem, HYDROMETER_MAX_SOURCES,
+                    (unsigned)semEspaco);
+        }
+        return false;
+    }
+    if (novaFonte) {
+        addLogf("Hidrômetro %s (%s): gravidade=%.4f, ângulo=%.1f", packet.nome, origem, packet.gravidade, packet.angulo);
+    }
+    return true;
+}
+
+void beginHydrometerListener() {
+    if (!hydrometerUdp.listen(HYDROMETER_UDP_PORT)) {
+        addLogf("Erro ao abrir porta UDP %d para hidrômetros", HYDROMETER_UDP_PORT);
+        return;
+    }
+    hydrometerUdp.onPacket([](AsyncUDPPacket packet) { ingestHydrometerPacket((const char *)packet.data(), packet.length(), "UDP"); });
+    addLogf("Recebendo hidrômetros via UDP na porta %d", HYDROMETER_UDP_PORT);
+}
+
+float getHydrometerGravity() {
+    unsigned long now = millis();
+    float gravidade = -1.0;
+    unsigned long maisRecente = 0;
+    bool encontrou = false;
+    portENTER_CRITICAL(&hydrometerMux);
+    for (int i = 0; i < HYDROMETER_MAX_SOURCES; i++) {
+        HydrometerSource &source = hydrometerSources[i];
+        if (source.recebidos == 0) {
+            continue;
+        }
+        if (source.ativo && now - source.ultimaLeituraMs > HYDROMETER_STALE_MS) {
+            source.ativo = false;
+            hydrometerStats.versao++;
+        }
+        if (source.ativo && (!encontrou || (long)(source.ultimaLeituraMs - maisRecente) > 0)) {
+            encontrou = true;
+            maisRecente = source.ultimaLeituraMs;
+            gravidade = source.gravidade;
+        }
+    }
+    portEXIT_CRITICAL(&hydrometerMux);
+    return gravidade;
+}
+
+size_t getHydrometerSources(HydrometerSource *sources, size_t maxSources) {
+    size_t count = 0;
+    portENTER_CRITICAL(&hydrometerMux);
+    for (int i = 0; i < HYDROMETER_MAX_SOURCES && count < maxSources; i++) {
+        if (hydrometerSources[i].recebidos > 0) {
+            sources[count++] = hydrometerSources[i];
+        }
+    }
+    portEXIT_CRITICAL(&hydrometerMux);
+    return count;
+}
+
+// Chamado só depois de a requisição ser admitida no primeiro fragmento
+// (ver setupAPIEndpoints); sem memória, responde aqui mesmo.
+void handleHydrometerBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+    if (total > HYDROMETER_MAX_PACKET_SIZE) {
+        return;
+    }
+    if (index == 0 && request->_tempObject == NULL) {
+        request->_tempObject = malloc(total);
+        if (request->_tempObject == NULL) {
+            request->send(503, "text/plain", "Sem memória para o pacote de hidrômetro");
+            return;
+        }
+    }
+    if (request->_tempObject != NULL && index + len <= total) {
+        memcpy((uint8_t *)request->_tempObject + index, data, len);
+    }
+}
+
+void handlePostHydrometer(AsyncWebServerRequest *request) {
+    size_t length = request->contentLength();
+    if (length > HYDROMETER_MAX_PACKET_SIZE) {
+        request->send(413, "text/plain", "Pacote de hidrômetro muito grande");
+        return;
+    }
+    if (request->_tempObject == NULL || length == 0) {
+        request->send(400, "text/plain", "Nenhum dado recebido no body");
+        return;
+    }
+    if (!ingestHydrometerPacket((const char *)request->_tempObject, length, "HTTP")) {
+        request->send(400, "text/plain", "Pacote de hidrômetro inválido");
+        return;
+    }
+    request->send(200, "application/json", "{\"status\":\"success\"}");
+}
@@ -0,0 +1,96 @@
+#include "hidrometro_parser.h"
+#include <ArduinoJson.h>
+#include <math.h>
+#include <string.h>
+
+static bool inRange(float value, float minimo, float maximo) {
+    return !isnan(value) && value >= minimo && value <= maximo;
+}
+
+bool parseHydrometerGravityUnit(const char *text, HydrometerGravityUnit &unit) {
+    if (text == nullptr) {
+        return false;
+    }
+    if (strcmp(text, "SG") == 0 || strcmp(text, "G") == 0) {
+        unit = HIDROMETRO_SG;
+        return true;
+    }
+    if (strcmp(text, "P") == 0) {
+        unit = HIDROMETRO_PLATO;
+        return true;
+    }
+    return false;
+}
+
+const char *getHydrometerGravityUnitString(HydrometerGravityUnit unit) {
+    return unit == HIDROMETRO_PLATO ? "P" : "SG";
+}
+
+static bool convertTemperature(const char *unidade, float &temperatura) {
+    if (strcmp(unidade, "C") == 0) {
+        return true;
+    }
+    if (strcmp(unidade, "F") == 0) {
+        temperatura = (temperatura - 32.0) * 5.0 / 9.0;
+        return true;
+    }
+    if (strcmp(unidade, "K") == 0) {
+        temperatura = temperatura - 273.15;
+        return true;
+    }
+    return false;
+}
+
+bool parseHydrometerPacket(const char *data, size_t length, HydrometerGravityUnit unidadePadrao, JsonPoolAllocator &pool,
+                           HydrometerPacket &packet) {
+    if (data == nullptr || length == 0 || length > HYDROMETER_MAX_PACKET_SIZE) {
+        return false;
+    }
+    JsonDocument filter(&pool);
+    filter["name"] = true;
+    filter["ID"] = true;
+    filter["angle"] = true;
+    filter["temperature"] = true;
+    filter["temp_units"] = true;
+    filter["battery"] = true;
+    filter["gravity"] = true;
+    filter["gravity_unit"] = true;
+    if (filter.overflowed()) {
+        return false;
+    }
+    JsonDocument doc(&pool);
+    if (deserializeJson(doc, data, length, DeserializationOption::Filter(filter), DeserializationOption::NestingLimit(2))) {
+        return false;
+    }
+    if (!doc["gravity"].is<float>() || (!doc["ID"].is<uint32_t>() && !doc["name"].is<const char *>())) {
+        return false;
+    }
+    HydrometerGravityUnit unidadeGravidade = unidadePadrao;
+    if (!doc["gravity_unit"].isNull() && !parseHydrometerGravityUnit(doc["gravity_unit"].as<const char *>(), unidadeGravidade)) {
+        return false;
+    }
+    packet.id = doc["ID"] | 0u;
+    strncpy(packet.nome, doc["name"] | "", sizeof(packet.nome) - 1);
+    packet.nome[sizeof(packet.nome) - 1] = '\0';
+    packet.gravidade = doc["gravity"].as<float>();
+    packet.angulo = doc["angle"] | NAN;
+    packet.temperatura = doc["temperature"] | NAN;
+    packet.bateria = doc["battery"] | NAN;
+    if (unidadeGravidade == HIDROMETRO_PLATO) {
+        float plato = packet.gravidade;
+        if (!inRange(plato, -5.0, 40.0)) {
+            return false;
+        }
+        packet.gravidade = 1.0 + plato / (258.6 - (plato / 258.2) * 227.1);
+    }
+    if (!isnan(packet.temperatura) && !convertTemperature(doc["temp_units"] | "C", packet.temperatura)) {
+        return false;
+    }
+    if (!inRange(packet.gravidade, 0.980, 1.200) ||
+        (!isnan(packet.angulo) && !inRange(packet.angulo, 0.0, 90.0)) ||
+        (!isnan(packet.temperatura) && !inRange(packet.temperatura, -10.0, 110.0)) ||
+        (!isnan(packet.bateria) && !inRange(packet.bateria, 0.0, 6.0))) {
+        return false;
+    }
+    return true;
+}
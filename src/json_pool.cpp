@@ -0,0 +1,74 @@
+#include "json_pool.h"
+#include <string.h>
+
+static const size_t BLOCK_ALIGN = 8;
+static const size_t BLOCK_HEADER = JSON_POOL_BLOCK_HEADER;
+
+static size_t alignBlock(size_t size) {
+    return (size + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+}
+
+static size_t &blockSize(void *pointer) {
+    return *(size_t *)((uint8_t *)pointer - BLOCK_HEADER);
+}
+
+JsonPoolAllocator::JsonPoolAllocator(uint8_t *buffer, size_t capacity)
+    : buffer(buffer), capacityBytes(capacity), usedBytes(0), peakBytes(0), lastBlockOffset(0), liveBlocks(0), failedAllocations(0) {}
+
+void *JsonPoolAllocator::allocate(size_t size) {
+    size_t total = BLOCK_HEADER + alignBlock(size);
+    if (usedBytes + total > capacityBytes) {
+        failedAllocations++;
+        return nullptr;
+    }
+    lastBlockOffset = usedBytes;
+    uint8_t *block = buffer + usedBytes + BLOCK_HEADER;
+    blockSize(block) = alignBlock(size);
+    usedBytes += total;
+    if (usedBytes > peakBytes)
+        peakBytes = usedBytes;
+    liveBlocks++;
+    return block;
+}
+
+void JsonPoolAllocator::deallocate(void *pointer) {
+    if (pointer == nullptr || liveBlocks == 0) {
+        return;
+    }
+    liveBlocks--;
+    if (liveBlocks == 0) {
+        usedBytes = 0;
+        lastBlockOffset = 0;
+    } else if ((uint8_t *)pointer == buffer + lastBlockOffset + BLOCK_HEADER) {
+        usedBytes = lastBlockOffset;
+    }
+}
+
+void *JsonPoolAllocator::reallocate(void *pointer, size_t newSize) {
+    if (pointer == nullptr) {
+        return allocate(newSize);
+    }
+    if ((uint8_t *)pointer == buffer + lastBlockOffset + BLOCK_HEADER) {
+        size_t total = BLOCK_HEADER + alignBlock(newSize);
+        if (lastBlockOffset + total > capacityBytes) {
+            failedAllocations++;
+            return nullptr;
+        }
+        blockSize(pointer) = alignBlock(newSize);
+        usedBytes = lastBlockOffset + total;
+        if (usedBytes > peakBytes)
+            peakBytes = usedBytes;
+        return pointer;
+    }
+    size_t oldSize = blockSize(pointer);
+    if (alignBlock(newSize) <= oldSize) {
+        return pointer;
+    }
+    void *block = allocate(newSize);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    memcpy(block, pointer, oldSize < newSize ? oldSize : newSize);
+    deallocate(pointer);
+    return block;
+}
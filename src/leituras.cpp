@@ -0,0 +1,42 @@
+#include "leituras.h"
+#include "config.h"
+
+static ReadingSnapshot readingSnapshot = {0.0, 0.0, 0.0, -1.0, false, false, false, 0};
+static portMUX_TYPE readingMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Arredonda para a resolução do sensor, para que o ruído abaixo dela não
+// gere uma nova versão (e invalide o ETag de /api/readings) a cada loop.
+static float quantize(float value, float resolucao) {
+    return roundf(value / resolucao) * resolucao;
+}
+
+void publishReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
+    tempFermentador = quantize(tempFermentador, READING_TEMP_RESOLUTION);
+    tempAmbiente = quantize(tempAmbiente, READING_TEMP_RESOLUTION);
+    tempDegelo = quantize(tempDegelo, READING_TEMP_RESOLUTION);
+    if (gravidade != -1.0) {
+        gravidade = quantize(gravidade, READING_GRAVITY_RESOLUTION);
+    }
+    portENTER_CRITICAL(&readingMux);
+    if (readingSnapshot.versao == 0 || readingSnapshot.tempFermentador != tempFermentador || readingSnapshot.tempAmbiente != tempAmbiente ||
+        readingSnapshot.tempDegelo != tempDegelo || readingSnapshot.gravidade != gravidade ||
+        readingSnapshot.releAquecimento != currentRelayAquecimentoState || readingSnapshot.releResfriamento != currentRelayResfriamentoState ||
+        readingSnapshot.releDegelo != currentRelayDegeloState) {
+        readingSnapshot.tempFermentador = tempFermentador;
+        readingSnapshot.tempAmbiente = tempAmbiente;
+        readingSnapshot.tempDegelo = tempDegelo;
+        readingSnapshot.gravidade = gravidade;
+        readingSnapshot.releAquecimento = currentRelayAquecimentoState;
+        readingSnapshot.releResfriamento = currentRelayResfriamentoState;
+        readingSnapshot.releDegelo = currentRelayDegeloState;
+        readingSnapshot.versao++;
+    }
+    portEXIT_CRITICAL(&readingMux);
+}
+
+ReadingSnapshot getReadingSnapshot() {
+    portENTER_CRITICAL(&readingMux);
+    ReadingSnapshot snapshot = readingSnapshot;
+    portEXIT_CRITICAL(&readingMux);
+    return snapshot;
+}
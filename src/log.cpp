@@ -1,13 +1,31 @@
 #include "log.h"
 #include "config.h"
+#include <stdarg.h>
 
-void addLog(String message) {
-    logs[currentLogIndex] = message;
+static void storeLog(const char *message) {
+    strncpy(logs[currentLogIndex], message, LOG_LINE_SIZE - 1);
+    logs[currentLogIndex][LOG_LINE_SIZE - 1] = '\0';
+    if (DEBUG_MODE) {
+        Serial.println(logs[currentLogIndex]);
+    }
     currentLogIndex = (currentLogIndex + 1) % MAX_LOGS;
     if (currentLogIndex == 0)
         logBufferFull = true;
+}
 
-    if (DEBUG_MODE) {
-        Serial.println(message);
-    }
-} 
\ No newline at end of file
+void addLog(const char *message) {
+    storeLog(message);
+}
+
+void addLog(const String &message) {
+    storeLog(message.c_str());
+}
+
+void addLogf(const char *format, ...) {
+    char message[LOG_LINE_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    storeLog(message);
+}
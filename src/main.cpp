@@ -6,6 +6,12 @@
 #include "storage.h"
 #include "wifi_manager.h"
 #include "api.h"
+#include "heap.h"
+#include "telemetria.h"
+#include "transporte.h"
+#include "trace.h"
+#include "leituras.h"
+#include "hidrometro.h"
 #include <ESPAsyncWebServer.h>
 #include <WiFi.h>
 
@@ -15,9 +21,12 @@ void setup() {
     Serial.begin(115200);
     delay(100);
     addLog("Iniciando FermenStation...");
-    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) { addLog("Evento WiFi: " + String(event)); });
+    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) { 
+        addLogf("Evento WiFi: %d", (int)event);
+        traceWifiEvent(event);
+    });
     for (int i = 0; i < MAX_LOGS; i++) {
-        logs[i] = "";
+        logs[i][0] = '\0';
     }
     pinMode(RELAY_PIN_AQUECIMENTO, OUTPUT);
     pinMode(RELAY_PIN_RESFRIAMENTO, OUTPUT);
@@ -39,11 +48,15 @@ void setup() {
         addLog("ERRO: Sensor de degelo (GPIO18) não encontrado!");
     }
     loadConfigurations();
+    traceBegin();
+    selectTelemetryTransport();
     connectToWiFi();
+    beginHydrometerListener();
 }
 
 void loop() {
     checkWiFiConnection();
+    telemetryTransport->loop();
     if (digitalRead(RESET_BUTTON_PIN) == LOW) {
         if (buttonPressStartTime == 0) {
             buttonPressStartTime = millis();
@@ -65,24 +78,43 @@ void loop() {
     float tempFermentador = readDSTemperature(tempFermentadorAddress, sensorFermentador);
     float tempAmbiente = readDSTemperature(tempAmbienteAddress, sensorAmbiente);
     float tempDegelo = readDSTemperature(tempDegeloAddress, sensorDegelo);
-    float gravidade = -1.0;
+    float gravidade = getHydrometerGravity();
+    // /api/readings mostra a leitura real: -127 indica sonda desconectada,
+    // antes da substituição pelos valores simulados abaixo.
+    publishReadings(tempFermentador, tempAmbiente, tempDegelo, gravidade);
     if (tempFermentador == -127.0)
         tempFermentador = 25.0 + sin(millis() / 10000.0) * 2.0;
     if (tempAmbiente == -127.0)
         tempAmbiente = 26.5 + cos(millis() / 15000.0) * 1.5;
     if (tempDegelo == -127.0)
         tempDegelo = 4.0 + sin(millis() / 8000.0) * 1.0;
-    if (millis() - lastSensorReadTime >= SENSOR_READ_INTERVAL_MS) {
+    if (millis() - lastSensorReadTime >= getTelemetryInterval()) {
         lastSensorReadTime = millis();
-        addLog("Temperaturas lidas: Fermentador=" + String(tempFermentador) + "°C, Ambiente=" + String(tempAmbiente) + "°C, Degelo=" + String(tempDegelo) + "°C");
-        if (wifiConnected && processFound && savedProcessId.length() > 0) {
-            extern void controlFermenstationOnSupabase(float, float, float, float);
-            controlFermenstationOnSupabase(tempFermentador, tempAmbiente, tempDegelo, gravidade);
+#ifdef ZERO_HEAP_MODE
+        beginCycleAllocationCount();
+#endif
+        addLogf("Temperaturas lidas: Fermentador=%.2f°C, Ambiente=%.2f°C, Degelo=%.2f°C", tempFermentador, tempAmbiente, tempDegelo);
+        traceReading(tempFermentador, tempAmbiente, tempDegelo, gravidade);
+        if (telemetryTransport->connected() && processFound && savedProcessId.length() > 0) {
+            TelemetryReason reason = evaluateTelemetry(tempFermentador, tempAmbiente, tempDegelo, gravidade, !telemetryTransport->pushesCommands());
+            if (reason == TELEMETRIA_SUPRIMIDA) {
+                addLogf("Telemetria suprimida (enviados=%u, suprimidos=%u)", (unsigned)telemetryStats.enviados, (unsigned)telemetryStats.suprimidos);
+            } else if (telemetryTransport->sendReadings(tempFermentador, tempAmbiente, tempDegelo, gravidade)) {
+                markTelemetrySent(tempFermentador, tempAmbiente, tempDegelo, gravidade);
+                addLogf("Telemetria enviada (motivo: %s)", getTelemetryReasonString(reason));
+            } else {
+                markTelemetryFailed();
+            }
         } else {
             addLog("Modo Offline/Fallback: Sem WiFi ou processo ativo. Usando controle local.");
             localControlLogic(tempFermentador, tempAmbiente, tempDegelo);
         }
+#ifdef ZERO_HEAP_MODE
+        addLogf("Alocações no ciclo: %u", (unsigned)endCycleAllocationCount());
+#endif
+        logHeapStatus();
     }
+    traceFlush();
     debugAllSensors();
     delay(1000);
 } 
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "mqtt.h"
+#include "config.h"
+#include "log.h"
+#include "controle.h"
+#include "storage.h"
+#include "json_pool.h"
+#include "trace.h"
+#include <AsyncMqttClient.h>
+#include <ArduinoJson.h>
+
+static AsyncMqttClient mqttClient;
+
+static uint8_t mqttJsonBuffer[MQTT_JSON_POOL_SIZE] __attribute__((aligned(8)));
+JsonPoolAllocator mqttJsonPool(mqttJsonBuffer, sizeof(mqttJsonBuffer));
+
+static char mqttHost[64];
+static char mqttUsuario[64];
+static char mqttSenha[64];
+static char mqttClientId[64];
+static char topicStatus[96];
+static char topicTelemetria[96];
+static char topicComando[96];
+static char topicProcesso[96];
+
+static char mqttMessage[MQTT_MESSAGE_MAX_SIZE];
+static size_t mqttMessageLength = 0;
+static bool mqttMessageOverflow = false;
+
+static volatile bool mqttSessionActive = false;
+static volatile bool processMessagePending = false;
+static bool mqttConfigured = false;
+static unsigned long lastMqttConnectAttempt = 0;
+
+static char pendingProcessId[64];
+static bool pendingProcessFound = false;
+static float pendingTemperaturaAlvo = 20.0;
+static float pendingVariacao = 0.5;
+
+static portMUX_TYPE commandMux = portMUX_INITIALIZER_UNLOCKED;
+static bool commandMessagePending = false;
+static CloudCommand pendingComando = {false, false, false};
+static char pendingAcao[96];
+
+// Roda na task do AsyncMqttClient: só guarda o comando; os relés são
+// acionados em MqttTransport::loop(), na task principal. Comandos sem os
+// três relés como booleanos são descartados em vez de desligar tudo.
+static bool handleComando(JsonDocument &doc) {
+    if (!doc["releAquecimento"].is<bool>() || !doc["releResfriamento"].is<bool>() || !doc["releDegelo"].is<bool>()) {
+        return false;
+    }
+    CloudCommand comando = {doc["releAquecimento"].as<bool>(), doc["releResfriamento"].as<bool>(), doc["releDegelo"].as<bool>()};
+    const char *acao = doc["acaoTomada"] | "";
+    portENTER_CRITICAL(&commandMux);
+    pendingComando = comando;
+    strncpy(pendingAcao, acao, sizeof(pendingAcao) - 1);
+    pendingAcao[sizeof(pendingAcao) - 1] = '\0';
+    commandMessagePending = true;
+    portEXIT_CRITICAL(&commandMux);
+    return true;
+}
+
+static bool handleProcesso(JsonDocument &doc) {
+    if (!doc["process_found"].is<bool>()) {
+        return false;
+    }
+    bool idValido = readProcessId(doc["process_id"], pendingProcessId, sizeof(pendingProcessId));
+    pendingProcessFound = doc["process_found"].as<bool>() && idValido;
+    pendingTemperaturaAlvo = doc["temperatura_alvo_receita"] | 20.0;
+    pendingVariacao = doc["variacao_aceitavel_receita"] | 0.5;
+    processMessagePending = true;
+    return true;
+}
+
+static void onMqttMessage(char *topic, char *payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total) {
+    if (index == 0) {
+        mqttMessageLength = 0;
+        mqttMessageOverflow = total > sizeof(mqttMessage);
+    }
+    if (mqttMessageOverflow) {
+        if (index + len == total) {
+            addLogf("Mensagem MQTT rejeitada em %s: %u bytes excede o limite", topic, (unsigned)total);
+        }
+        return;
+    }
+    memcpy(mqttMessage + index, payload, len);
+    mqttMessageLength = index + len;
+    if (mqttMessageLength < total) {
+        return;
+    }
+    bool comando = strcmp(topic, topicComando) == 0;
+    JsonDocument filter(&mqttJsonPool);
+    if (comando) {
+        filter["releAquecimento"] = true;
+        filter["releResfriamento"] = true;
+        filter["releDegelo"] = true;
+        filter["acaoTomada"] = true;
+    } else {
+        filter["process_found"] = true;
+        filter["process_id"] = true;
+        filter["temperatura_alvo_receita"] = true;
+        filter["variacao_aceitavel_receita"] = true;
+    }
+    if (filter.overflowed()) {
+        addLogf("Mensagem MQTT descartada em %s: pool JSON esgotado", topic);
+        return;
+    }
+    JsonDocument doc(&mqttJsonPool);
+    DeserializationError error = deserializeJson(doc, mqttMessage, mqttMessageLength, DeserializationOption::Filter(filter),
+                                                 DeserializationOption::NestingLimit(SUPABASE_JSON_NESTING_LIMIT));
+    if (error) {
+        addLogf("Mensagem MQTT inválida em %s: %s", topic, error.c_str());
+        return;
+    }
+    if (!(comando ? handleComando(doc) : handleProcesso(doc))) {
+        addLogf("Mensagem MQTT rejeitada em %s: campos obrigatórios ausentes ou não booleanos", topic);
+    }
+}
+
+static void onMqttConnect(bool sessionPresent) {
+    mqttSessionActive = true;
+    mqttClient.publish(topicStatus, 1, true, "online");
+    mqttClient.subscribe(topicProcesso, 1);
+    mqttClient.subscribe(topicComando, 1);
+    addLogf("MQTT conectado a %s (sessão %s)", mqttHost, sessionPresent ? "retomada" : "nova");
+}
+
+static void onMqttDisconnect(AsyncMqttClientDisconnectReason reason) {
+    mqttSessionActive = false;
+    addLogf("MQTT desconectado (motivo %d)", (int)reason);
+}
+
+static void configureMqttClient() {
+    if (mqttConfigured) {
+        return;
+    }
+    strlcpy(mqttHost, savedMqttHost.c_str(), sizeof(mqttHost));
+    strlcpy(mqttUsuario, savedMqttUsuario.c_str(), sizeof(mqttUsuario));
+    strlcpy(mqttSenha, savedMqttSenha.c_str(), sizeof(mqttSenha));
+    snprintf(mqttClientId, sizeof(mqttClientId), "fermenstation-%s", savedDeviceId.c_str());
+    snprintf(topicStatus, sizeof(topicStatus), "fermenstation/%s/status", savedDeviceId.c_str());
+    snprintf(topicTelemetria, sizeof(topicTelemetria), "fermenstation/%s/telemetria", savedDeviceId.c_str());
+    snprintf(topicComando, sizeof(topicComando), "fermenstation/%s/comando", savedDeviceId.c_str());
+    snprintf(topicProcesso, sizeof(topicProcesso), "fermenstation/%s/processo", savedDeviceId.c_str());
+    mqttClient.setServer(mqttHost, savedMqttPort);
+    mqttClient.setClientId(mqttClientId);
+    mqttClient.setCleanSession(false);
+    mqttClient.setKeepAlive(MQTT_KEEPALIVE_S);
+    if (mqttUsuario[0] != '\0') {
+        mqttClient.setCredentials(mqttUsuario, mqttSenha);
+    }
+    mqttClient.setWill(topicStatus, 1, true, "offline");
+    mqttClient.onConnect(onMqttConnect);
+    mqttClient.onDisconnect(onMqttDisconnect);
+    mqttClient.onMessage(onMqttMessage);
+    mqttConfigured = true;
+}
+
+static void applyPendingProcess() {
+    if (!processMessagePending) {
+        return;
+    }
+    processMessagePending = false;
+    if (pendingProcessFound && pendingProcessId[0] != '\0') {
+        savedProcessId = pendingProcessId;
+        savedTemperaturaAlvoLocal = pendingTemperaturaAlvo;
+        savedVariacaoTemperaturaLocal = pendingVariacao;
+        processFound = true;
+        addLogf("Processo ativo recebido via MQTT: %s", savedProcessId.c_str());
+    } else {
+        savedProcessId = "";
+        processFound = false;
+        addLog("Nenhum processo ativo publicado via MQTT.");
+    }
+    saveConfigurations();
+}
+
+static void applyPendingCommand() {
+    CloudCommand comando;
+    char acao[sizeof(pendingAcao)];
+    portENTER_CRITICAL(&commandMux);
+    bool pending = commandMessagePending;
+    commandMessagePending = false;
+    comando = pendingComando;
+    memcpy(acao, pendingAcao, sizeof(acao));
+    portEXIT_CRITICAL(&commandMux);
+    if (!pending) {
+        return;
+    }
+    if (!processFound || savedProcessId.length() == 0) {
+        addLog("Comando MQTT descartado: nenhum processo ativo.");
+        return;
+    }
+    traceResponse(TRACE_ORIGEM_MQTT, true, comando.aquecimento, comando.resfriamento, comando.degelo);
+    applyCloudCommand(TRACE_ORIGEM_MQTT, "MQTT", comando, acao);
+}
+
+bool MqttTransport::connected() {
+    return wifiConnected && mqttSessionActive;
+}
+
+bool MqttTransport::validateDevice() {
+    if (savedDeviceId.length() == 0) {
+        addLog("Device ID não configurado. Não é possível conectar ao broker MQTT.");
+        return false;
+    }
+    configureMqttClient();
+    if (!mqttSessionActive) {
+        addLogf("Conectando ao broker MQTT %s:%u", mqttHost, (unsigned)savedMqttPort);
+        lastMqttConnectAttempt = millis();
+        mqttClient.connect();
+    }
+    unsigned long startTime = millis();
+    while (!mqttSessionActive && millis() - startTime < MQTT_CONNECT_TIMEOUT_MS) {
+        delay(50);
+    }
+    return mqttSessionActive;
+}
+
+bool MqttTransport::getActiveProcess() {
+    unsigned long startTime = millis();
+    while (!processMessagePending && millis() - startTime < MQTT_CONNECT_TIMEOUT_MS) {
+        delay(50);
+    }
+    applyPendingProcess();
+    return processFound;
+}
+
+bool MqttTransport::sendReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
+    if (!mqttSessionActive) {
+        return false;
+    }
+    char payload[MQTT_TELEMETRY_SIZE];
+    int length = snprintf(payload, sizeof(payload), "%s,%.2f,%.2f,%.2f,%.4f", savedProcessId.c_str(), tempFermentador, tempAmbiente,
+                          tempDegelo, gravidade);
+    if (length <= 0 || length >= (int)sizeof(payload)) {
+        return false;
+    }
+    uint16_t packetId = mqttClient.publish(topicTelemetria, 1, false, payload, length);
+    addLogf("Telemetria MQTT publicada (%d bytes, pacote %u)", length, (unsigned)packetId);
+    return packetId != 0;
+}
+
+void MqttTransport::loop() {
+    applyPendingProcess();
+    applyPendingCommand();
+    if (!wifiConnected || mqttSessionActive || !mqttConfigured) {
+        return;
+    }
+    if (millis() - lastMqttConnectAttempt >= MQTT_RECONNECT_INTERVAL_MS) {
+        lastMqttConnectAttempt = millis();
+        addLog("Reconectando ao broker MQTT...");
+        mqttClient.connect();
+    }
+}
+
+MqttTransport mqttTransport;
@@ -1,6 +1,9 @@
 #include "storage.h"
 #include "config.h"
 #include "log.h"
+#include "trace.h"
+#include "api_cache.h"
+#include "hidrometro_parser.h"
 
 void saveConfigurations() {
     preferences.begin("fermenstation", false);
@@ -15,7 +18,19 @@ void saveConfigurations() {
     preferences.putFloat("tempMaxSeg", savedTemperaturaMaxSeguranca);
     preferences.putFloat("tempAlvoLocal", savedTemperaturaAlvoLocal);
     preferences.putFloat("variacaoTempLocal", savedVariacaoTemperaturaLocal);
+    preferences.putFloat("telDeadband", savedTelemetriaDeadband);
+    preferences.putULong("telHeartbeat", savedTelemetriaHeartbeatS);
+    preferences.putFloat("telRampa", savedTelemetriaRampa);
+    preferences.putULong("telControle", savedTelemetriaControleS);
+    preferences.putString("transporte", savedTransporte);
+    preferences.putUChar("hidUnidade", savedHidrometroUnidade);
+    preferences.putString("mqttHost", savedMqttHost);
+    preferences.putUShort("mqttPort", savedMqttPort);
+    preferences.putString("mqttUsuario", savedMqttUsuario);
+    preferences.putString("mqttSenha", savedMqttSenha);
     preferences.end();
+    traceConfig();
+    bumpConfigVersion();
     addLog("Configurações salvas na memória persistente.");
 }
 
@@ -32,7 +47,18 @@ void loadConfigurations() {
     savedTemperaturaMaxSeguranca = preferences.getFloat("tempMaxSeg", 35.0);
     savedTemperaturaAlvoLocal = preferences.getFloat("tempAlvoLocal", 20.0);
     savedVariacaoTemperaturaLocal = preferences.getFloat("variacaoTempLocal", 0.5);
+    savedTelemetriaDeadband = preferences.getFloat("telDeadband", 0.2);
+    savedTelemetriaHeartbeatS = preferences.getULong("telHeartbeat", 600);
+    savedTelemetriaRampa = preferences.getFloat("telRampa", 1.0);
+    savedTelemetriaControleS = preferences.getULong("telControle", 120);
+    savedTransporte = preferences.getString("transporte", "supabase");
+    savedHidrometroUnidade = preferences.getUChar("hidUnidade", HIDROMETRO_SG);
+    savedMqttHost = preferences.getString("mqttHost", "");
+    savedMqttPort = preferences.getUShort("mqttPort", 1883);
+    savedMqttUsuario = preferences.getString("mqttUsuario", "");
+    savedMqttSenha = preferences.getString("mqttSenha", "");
     preferences.end();
+    bumpConfigVersion();
     addLog("Configurações carregadas da memória persistente.");
 }
 
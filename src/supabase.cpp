@@ -1,29 +1,60 @@
 #include "supabase.h"
 #include "config.h"
 #include "log.h"
+#include "json_pool.h"
+#include "bounded_reader.h"
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include "storage.h"
 #include "controle.h"
+#include "trace.h"
 
-String callSupabaseRpc(const String &rpcName, const String &payload) {
+static uint8_t supabaseJsonBuffer[JSON_POOL_SIZE] __attribute__((aligned(8)));
+JsonPoolAllocator supabaseJsonPool(supabaseJsonBuffer, sizeof(supabaseJsonBuffer));
+
+static char supabasePayload[SUPABASE_PAYLOAD_SIZE];
+
+bool callSupabaseRpc(const char *rpcName, const char *payload, JsonDocument &filter, JsonDocument &responseDoc) {
     HTTPClient http;
-    String url = String(SUPABASE_URL) + "/rpc/" + rpcName;
+    char url[160];
+    char authorization[SUPABASE_PAYLOAD_SIZE];
+    snprintf(url, sizeof(url), "%s/rpc/%s", SUPABASE_URL, rpcName);
+    snprintf(authorization, sizeof(authorization), "Bearer %s", SUPABASE_ANON_KEY);
+    http.useHTTP10(true);
+    http.setTimeout(SUPABASE_RESPONSE_TIMEOUT_MS);
     http.begin(url);
     http.addHeader("Content-Type", "application/json");
     http.addHeader("apikey", SUPABASE_ANON_KEY);
-    http.addHeader("Authorization", "Bearer " + String(SUPABASE_ANON_KEY));
-    addLog("Chamando RPC: " + rpcName + " com payload: " + payload);
-    int httpResponseCode = http.POST(payload);
-    String response = "";
-    if (httpResponseCode > 0) {
-        response = http.getString();
-        addLog("Resposta RPC (" + String(httpResponseCode) + "): " + response);
-    } else {
-        addLog("Erro na chamada RPC (" + String(httpResponseCode) + "): " + http.errorToString(httpResponseCode));
+    http.addHeader("Authorization", authorization);
+    addLogf("Chamando RPC: %s com payload: %s", rpcName, payload);
+    int httpResponseCode = http.POST((uint8_t *)payload, strlen(payload));
+    if (httpResponseCode <= 0) {
+        addLogf("Erro na chamada RPC (%d): %s", httpResponseCode, http.errorToString(httpResponseCode).c_str());
+        http.end();
+        return false;
+    }
+    if (httpResponseCode < 200 || httpResponseCode >= 300) {
+        addLogf("Resposta RPC %s rejeitada: HTTP %d", rpcName, httpResponseCode);
+        http.end();
+        return false;
     }
+    int contentLength = http.getSize();
+    unsigned long parseStart = micros();
+    BoundedJsonResult result = deserializeBoundedJson(responseDoc, http.getStream(), contentLength, SUPABASE_RESPONSE_MAX_SIZE,
+                                                      SUPABASE_RESPONSE_TIMEOUT_MS, filter, SUPABASE_JSON_NESTING_LIMIT);
+    unsigned long parseTime = micros() - parseStart;
     http.end();
-    return response;
+    if (result.tooLarge) {
+        addLogf("Resposta RPC %s rejeitada: %d bytes excede o limite de %d", rpcName, contentLength, SUPABASE_RESPONSE_MAX_SIZE);
+        return false;
+    }
+    if (result.error) {
+        addLogf("Resposta RPC %s rejeitada (%d bytes%s): %s", rpcName, (int)result.consumed,
+                result.timedOut ? ", prazo esgotado" : "", result.error.c_str());
+        return false;
+    }
+    addLogf("Resposta RPC %s (HTTP %d): %d bytes, parse em %lu us", rpcName, httpResponseCode, (int)result.consumed, parseTime);
+    return true;
 }
 
 bool validateDeviceOnSupabase() {
@@ -31,22 +62,21 @@ bool validateDeviceOnSupabase() {
         addLog("Device ID não configurado. Não é possível validar no Supabase.");
         return false;
     }
-    JsonDocument doc;
-    doc["p_device_id"] = savedDeviceId;
-    String payload;
-    serializeJson(doc, payload);
-    String response = callSupabaseRpc("rpc_validate_device", payload);
-    JsonDocument responseDoc;
-    DeserializationError error = deserializeJson(responseDoc, response);
-    if (error) {
-        addLog("Erro ao parsear resposta de validação do dispositivo: " + String(error.f_str()));
+    JsonDocument doc(&supabaseJsonPool);
+    doc["p_device_id"] = savedDeviceId.c_str();
+    serializeJson(doc, supabasePayload, sizeof(supabasePayload));
+    doc.clear();
+    JsonDocument filter(&supabaseJsonPool);
+    filter["status"] = true;
+    filter["message"] = true;
+    if (!callSupabaseRpc("rpc_validate_device", supabasePayload, filter, doc)) {
         return false;
     }
-    if (responseDoc["status"] == "success") {
+    if (doc["status"] == "success") {
         addLog("Dispositivo validado com sucesso no Supabase.");
         return true;
     } else {
-        addLog("Falha na validação do dispositivo no Supabase: " + responseDoc["message"].as<String>());
+        addLogf("Falha na validação do dispositivo no Supabase: %s", doc["message"] | "");
         return false;
     }
 }
@@ -56,63 +86,86 @@ bool getActiveProcessOnSupabase() {
         addLog("Device ID não configurado. Não é possível buscar processo ativo.");
         return false;
     }
-    JsonDocument doc;
-    doc["p_device_id"] = savedDeviceId;
-    String payload;
-    serializeJson(doc, payload);
-    String response = callSupabaseRpc("rpc_get_active_process", payload);
-    JsonDocument responseDoc;
-    DeserializationError error = deserializeJson(responseDoc, response);
-    if (error) {
-        addLog("Erro ao parsear resposta de processo ativo: " + String(error.f_str()));
+    JsonDocument doc(&supabaseJsonPool);
+    doc["p_device_id"] = savedDeviceId.c_str();
+    serializeJson(doc, supabasePayload, sizeof(supabasePayload));
+    doc.clear();
+    JsonDocument filter(&supabaseJsonPool);
+    filter["process_found"] = true;
+    filter["process_id"] = true;
+    filter["temperatura_alvo_receita"] = true;
+    filter["variacao_aceitavel_receita"] = true;
+    filter["message"] = true;
+    if (!callSupabaseRpc("rpc_get_active_process", supabasePayload, filter, doc)) {
         return false;
     }
-    if (responseDoc["process_found"] == true) {
-        savedProcessId = responseDoc["process_id"].as<String>();
-        savedTemperaturaAlvoLocal = responseDoc["temperatura_alvo_receita"] | 20.0;
-        savedVariacaoTemperaturaLocal = responseDoc["variacao_aceitavel_receita"] | 0.5;
-        addLog("Processo ativo encontrado: " + savedProcessId);
+    char processId[64];
+    bool idValido = readProcessId(doc["process_id"], processId, sizeof(processId));
+    if (doc["process_found"] == true && !idValido) {
+        addLog("Processo ativo sem process_id válido; tratado como nenhum processo.");
+    }
+    if (doc["process_found"] == true && idValido) {
+        savedProcessId = processId;
+        savedTemperaturaAlvoLocal = doc["temperatura_alvo_receita"] | 20.0;
+        savedVariacaoTemperaturaLocal = doc["variacao_aceitavel_receita"] | 0.5;
+        addLogf("Processo ativo encontrado: %s", savedProcessId.c_str());
         saveConfigurations();
         return true;
     } else {
-        addLog("Nenhum processo ativo encontrado: " + responseDoc["message"].as<String>());
+        addLogf("Nenhum processo ativo encontrado: %s", doc["message"] | "");
         savedProcessId = "";
         saveConfigurations();
         return false;
     }
 }
 
-void controlFermenstationOnSupabase(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
+bool controlFermenstationOnSupabase(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
     if (!processFound || savedProcessId.length() == 0) {
         addLog("Nenhum processo ativo ou ID do processo. Não é possível controlar via Supabase.");
-        return;
+        return false;
     }
-    JsonDocument doc;
-    doc["p_device_id"] = savedDeviceId;
-    doc["p_processo_id"] = savedProcessId;
+    JsonDocument doc(&supabaseJsonPool);
+    doc["p_device_id"] = savedDeviceId.c_str();
+    doc["p_processo_id"] = savedProcessId.c_str();
     doc["p_temp_fermentador"] = tempFermentador;
     doc["p_temp_ambiente"] = tempAmbiente;
     doc["p_temp_degelo"] = tempDegelo;
     if (gravidade != -1.0) {
         doc["p_gravidade"] = gravidade;
     }
-    String payload;
-    serializeJson(doc, payload);
-    String response = callSupabaseRpc("rpc_controlar_fermentacao", payload);
-    JsonDocument responseDoc;
-    DeserializationError error = deserializeJson(responseDoc, response);
-    if (error) {
-        addLog("Erro ao parsear resposta de controle de fermentação: " + String(error.f_str()));
-        return;
+    serializeJson(doc, supabasePayload, sizeof(supabasePayload));
+    doc.clear();
+    JsonDocument filter(&supabaseJsonPool);
+    filter["releAquecimento"] = true;
+    filter["releResfriamento"] = true;
+    filter["releDegelo"] = true;
+    filter["acaoTomada"] = true;
+    if (!callSupabaseRpc("rpc_controlar_fermentacao", supabasePayload, filter, doc)) {
+        traceResponse(TRACE_ORIGEM_SUPABASE, false, false, false, false);
+        return false;
     }
-    currentRelayAquecimentoState = responseDoc["releAquecimento"] | false;
-    currentRelayResfriamentoState = responseDoc["releResfriamento"] | false;
-    currentRelayDegeloState = responseDoc["releDegelo"] | false;
-    setRelayState(RELAY_PIN_AQUECIMENTO, currentRelayAquecimentoState);
-    setRelayState(RELAY_PIN_RESFRIAMENTO, currentRelayResfriamentoState);
-    setRelayState(RELAY_PIN_DEGELO, currentRelayDegeloState);
-    addLog("Relés atualizados pelo Supabase: Aquecimento=" + String(currentRelayAquecimentoState) +
-           ", Resfriamento=" + String(currentRelayResfriamentoState) +
-           ", Degelo=" + String(currentRelayDegeloState));
-    addLog("Ação tomada pelo Supabase: " + responseDoc["acaoTomada"].as<String>());
-} 
\ No newline at end of file
+    CloudCommand comando = {doc["releAquecimento"] | false, doc["releResfriamento"] | false, doc["releDegelo"] | false};
+    traceResponse(TRACE_ORIGEM_SUPABASE, true, comando.aquecimento, comando.resfriamento, comando.degelo);
+    applyCloudCommand(TRACE_ORIGEM_SUPABASE, "Supabase", comando, doc["acaoTomada"] | "");
+    return true;
+}
+
+bool SupabaseTransport::connected() {
+    return wifiConnected;
+}
+
+bool SupabaseTransport::validateDevice() {
+    return validateDeviceOnSupabase();
+}
+
+bool SupabaseTransport::getActiveProcess() {
+    return getActiveProcessOnSupabase();
+}
+
+bool SupabaseTransport::sendReadings(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
+    return controlFermenstationOnSupabase(tempFermentador, tempAmbiente, tempDegelo, gravidade);
+}
+
+void SupabaseTransport::loop() {}
+
+SupabaseTransport supabaseTransport;
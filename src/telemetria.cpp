@@ -0,0 +1,121 @@
+#include "telemetria.h"
+#include "config.h"
+
+TelemetryStats telemetryStats = {};
+
+static bool hasSentTelemetry = false;
+static unsigned long lastTelemetrySentTime = 0;
+static float lastSentFermentador = 0.0;
+static float lastSentAmbiente = 0.0;
+static float lastSentDegelo = 0.0;
+static float lastSentGravidade = -1.0;
+static bool lastSentAquecimento = false;
+static bool lastSentResfriamento = false;
+static bool lastSentDegeloRele = false;
+
+static bool hasRampReference = false;
+static unsigned long rampReferenceTime = 0;
+static float rampReferenceFermentador = 0.0;
+static bool emRampa = false;
+static bool fastReporting = false;
+
+static bool outsideDeadband(float current, float lastSent, float deadband) {
+    return fabs(current - lastSent) > deadband;
+}
+
+unsigned long getTelemetryInterval() {
+    return fastReporting ? TELEMETRY_FAST_INTERVAL_MS : SENSOR_READ_INTERVAL_MS;
+}
+
+TelemetryReason evaluateTelemetry(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade, bool pollControl) {
+    unsigned long now = millis();
+    if (!hasRampReference) {
+        hasRampReference = true;
+        rampReferenceTime = now;
+        rampReferenceFermentador = tempFermentador;
+    } else if (now - rampReferenceTime >= TELEMETRY_RAMP_WINDOW_MS) {
+        float taxaPorHora = (tempFermentador - rampReferenceFermentador) * 3600000.0 / (now - rampReferenceTime);
+        emRampa = fabs(taxaPorHora) > savedTelemetriaRampa;
+        rampReferenceTime = now;
+        rampReferenceFermentador = tempFermentador;
+    }
+    bool emAlarme = tempFermentador < savedTemperaturaMinSeguranca || tempFermentador > savedTemperaturaMaxSeguranca;
+    fastReporting = emRampa || emAlarme;
+
+    TelemetryReason reason = TELEMETRIA_SUPRIMIDA;
+    if (!hasSentTelemetry) {
+        reason = TELEMETRIA_PRIMEIRA;
+    } else if (emAlarme) {
+        reason = TELEMETRIA_ALARME;
+    } else if (emRampa) {
+        reason = TELEMETRIA_RAMPA;
+    } else if (currentRelayAquecimentoState != lastSentAquecimento || currentRelayResfriamentoState != lastSentResfriamento ||
+               currentRelayDegeloState != lastSentDegeloRele) {
+        reason = TELEMETRIA_RELE;
+    } else if (outsideDeadband(tempFermentador, lastSentFermentador, savedTelemetriaDeadband) ||
+               outsideDeadband(tempAmbiente, lastSentAmbiente, savedTelemetriaDeadband) ||
+               outsideDeadband(tempDegelo, lastSentDegelo, savedTelemetriaDeadband) ||
+               (gravidade != -1.0) != (lastSentGravidade != -1.0) ||
+               (gravidade != -1.0 && outsideDeadband(gravidade, lastSentGravidade, TELEMETRY_GRAVITY_DEADBAND))) {
+        reason = TELEMETRIA_DEADBAND;
+    } else if (pollControl && now - lastTelemetrySentTime >= savedTelemetriaControleS * 1000UL) {
+        reason = TELEMETRIA_CONTROLE;
+    } else if (now - lastTelemetrySentTime >= savedTelemetriaHeartbeatS * 1000UL) {
+        reason = TELEMETRIA_HEARTBEAT;
+    }
+
+    telemetryStats.porMotivo[reason]++;
+    if (reason == TELEMETRIA_SUPRIMIDA) {
+        telemetryStats.suprimidos++;
+    }
+    return reason;
+}
+
+void markTelemetrySent(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
+    hasSentTelemetry = true;
+    lastTelemetrySentTime = millis();
+    lastSentFermentador = tempFermentador;
+    lastSentAmbiente = tempAmbiente;
+    lastSentDegelo = tempDegelo;
+    lastSentGravidade = gravidade;
+    lastSentAquecimento = currentRelayAquecimentoState;
+    lastSentResfriamento = currentRelayResfriamentoState;
+    lastSentDegeloRele = currentRelayDegeloState;
+    telemetryStats.enviados++;
+}
+
+void markTelemetryFailed() {
+    telemetryStats.falhas++;
+}
+
+void resetTelemetry() {
+    telemetryStats = {};
+    hasSentTelemetry = false;
+    lastTelemetrySentTime = 0;
+    lastSentFermentador = 0.0;
+    lastSentAmbiente = 0.0;
+    lastSentDegelo = 0.0;
+    lastSentGravidade = -1.0;
+    lastSentAquecimento = false;
+    lastSentResfriamento = false;
+    lastSentDegeloRele = false;
+    hasRampReference = false;
+    rampReferenceTime = 0;
+    rampReferenceFermentador = 0.0;
+    emRampa = false;
+    fastReporting = false;
+}
+
+const char *getTelemetryReasonString(TelemetryReason reason) {
+    switch (reason) {
+        case TELEMETRIA_SUPRIMIDA: return "suprimida";
+        case TELEMETRIA_PRIMEIRA: return "primeira";
+        case TELEMETRIA_DEADBAND: return "deadband";
+        case TELEMETRIA_RELE: return "rele";
+        case TELEMETRIA_CONTROLE: return "controle";
+        case TELEMETRIA_HEARTBEAT: return "heartbeat";
+        case TELEMETRIA_RAMPA: return "rampa";
+        case TELEMETRIA_ALARME: return "alarme";
+        default: return "desconhecido";
+    }
+}
@@ -0,0 +1,177 @@
+#include "trace.h"
+#include "config.h"
+#include "log.h"
+#include <esp_partition.h>
+
+TraceStats traceStats = {};
+
+static const esp_partition_t *tracePartition = nullptr;
+static size_t traceSectorCount = 0;
+static size_t traceWriteOffset = 0;
+static uint8_t traceBuffer[TRACE_BUFFER_SIZE];
+static uint8_t traceStaging[TRACE_BUFFER_SIZE];
+static size_t traceBufferLength = 0;
+static portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+static TraceConfig flushedConfig;
+static bool hasFlushedConfig = false;
+
+static void traceAppend(TraceRecordType tipo, const void *payload, uint8_t tamanho) {
+    TraceRecordHeader header = {tipo, tamanho, (uint32_t)millis()};
+    portENTER_CRITICAL(&traceMux);
+    if (traceBufferLength + sizeof(header) + tamanho <= sizeof(traceBuffer)) {
+        memcpy(traceBuffer + traceBufferLength, &header, sizeof(header));
+        if (tamanho > 0) {
+            memcpy(traceBuffer + traceBufferLength + sizeof(header), payload, tamanho);
+        }
+        traceBufferLength += sizeof(header) + tamanho;
+    } else {
+        traceStats.descartados++;
+    }
+    portEXIT_CRITICAL(&traceMux);
+}
+
+static uint8_t packRelays(bool aquecimento, bool resfriamento, bool degelo) {
+    return (aquecimento ? TRACE_RELE_AQUECIMENTO : 0) | (resfriamento ? TRACE_RELE_RESFRIAMENTO : 0) | (degelo ? TRACE_RELE_DEGELO : 0);
+}
+
+// Cada setor começa com a última configuração gravada, para que o trace
+// continue reproduzível depois que o anel sobrescrever o registro original.
+static bool openSector(uint32_t setor, uint32_t tempoMs) {
+    size_t sectorOffset = setor * TRACE_SECTOR_SIZE;
+    if (esp_partition_erase_range(tracePartition, sectorOffset, TRACE_SECTOR_SIZE) != ESP_OK) {
+        return false;
+    }
+    TraceSectorHeader header = {TRACE_MAGIC, traceStats.sequencia + 1};
+    if (esp_partition_write(tracePartition, sectorOffset, &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    traceStats.sequencia = header.sequencia;
+    traceStats.setorAtual = setor;
+    traceWriteOffset = sizeof(header);
+    if (hasFlushedConfig) {
+        uint8_t record[sizeof(TraceRecordHeader) + sizeof(TraceConfig)];
+        TraceRecordHeader recordHeader = {TRACE_CONFIG, sizeof(TraceConfig), tempoMs};
+        memcpy(record, &recordHeader, sizeof(recordHeader));
+        memcpy(record + sizeof(recordHeader), &flushedConfig, sizeof(flushedConfig));
+        if (esp_partition_write(tracePartition, sectorOffset + traceWriteOffset, record, sizeof(record)) != ESP_OK) {
+            return false;
+        }
+        traceWriteOffset += sizeof(record);
+    }
+    return true;
+}
+
+static size_t findSectorEnd(uint32_t setor) {
+    size_t offset = sizeof(TraceSectorHeader);
+    while (offset + sizeof(TraceRecordHeader) <= TRACE_SECTOR_SIZE) {
+        TraceRecordHeader header;
+        if (esp_partition_read(tracePartition, setor * TRACE_SECTOR_SIZE + offset, &header, sizeof(header)) != ESP_OK ||
+            header.tipo == TRACE_VAZIO) {
+            break;
+        }
+        offset += sizeof(header) + header.tamanho;
+    }
+    return offset < TRACE_SECTOR_SIZE ? offset : TRACE_SECTOR_SIZE;
+}
+
+void traceBegin() {
+    tracePartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)TRACE_PARTITION_SUBTYPE, "trace");
+    if (tracePartition == nullptr) {
+        addLog("Partição de trace não encontrada. Gravação de trace desativada.");
+        return;
+    }
+    traceSectorCount = tracePartition->size / TRACE_SECTOR_SIZE;
+    bool found = false;
+    for (uint32_t setor = 0; setor < traceSectorCount; setor++) {
+        TraceSectorHeader header;
+        if (esp_partition_read(tracePartition, setor * TRACE_SECTOR_SIZE, &header, sizeof(header)) != ESP_OK || header.magic != TRACE_MAGIC) {
+            continue;
+        }
+        if (!found || header.sequencia > traceStats.sequencia) {
+            found = true;
+            traceStats.sequencia = header.sequencia;
+            traceStats.setorAtual = setor;
+        }
+    }
+    if (found) {
+        traceWriteOffset = findSectorEnd(traceStats.setorAtual);
+    } else if (!openSector(0, millis())) {
+        addLog("Erro ao inicializar a partição de trace.");
+        return;
+    }
+    traceStats.ativo = true;
+    addLogf("Trace ativo: %u setores, sequência %u", (unsigned)traceSectorCount, (unsigned)traceStats.sequencia);
+    traceAppend(TRACE_BOOT, nullptr, 0);
+    traceConfig();
+    traceFlush();
+}
+
+void traceFlush() {
+    if (!traceStats.ativo) {
+        return;
+    }
+    portENTER_CRITICAL(&traceMux);
+    size_t length = traceBufferLength;
+    memcpy(traceStaging, traceBuffer, length);
+    traceBufferLength = 0;
+    portEXIT_CRITICAL(&traceMux);
+    size_t offset = 0;
+    while (offset < length) {
+        const TraceRecordHeader *header = (const TraceRecordHeader *)(traceStaging + offset);
+        size_t recordSize = sizeof(TraceRecordHeader) + header->tamanho;
+        if (traceWriteOffset + recordSize > TRACE_SECTOR_SIZE &&
+            !openSector((traceStats.setorAtual + 1) % traceSectorCount, header->tempoMs)) {
+            traceStats.ativo = false;
+            addLog("Erro ao apagar setor de trace. Gravação de trace desativada.");
+            return;
+        }
+        if (esp_partition_write(tracePartition, traceStats.setorAtual * TRACE_SECTOR_SIZE + traceWriteOffset, traceStaging + offset, recordSize) != ESP_OK) {
+            traceStats.descartados++;
+        } else {
+            traceStats.gravados++;
+        }
+        if (header->tipo == TRACE_CONFIG && header->tamanho == sizeof(TraceConfig)) {
+            memcpy(&flushedConfig, traceStaging + offset + sizeof(TraceRecordHeader), sizeof(flushedConfig));
+            hasFlushedConfig = true;
+        }
+        traceWriteOffset += recordSize;
+        offset += recordSize;
+    }
+}
+
+void traceReading(float tempFermentador, float tempAmbiente, float tempDegelo, float gravidade) {
+    TraceLeitura leitura = {tempFermentador, tempAmbiente, tempDegelo, gravidade};
+    traceAppend(TRACE_LEITURA, &leitura, sizeof(leitura));
+}
+
+void traceWifiEvent(int evento) {
+    TraceWifi wifi = {evento};
+    traceAppend(TRACE_WIFI, &wifi, sizeof(wifi));
+}
+
+void traceResponse(TraceOrigem origem, bool ok, bool aquecimento, bool resfriamento, bool degelo) {
+    TraceResposta resposta = {origem, (uint8_t)((ok ? TRACE_RESPOSTA_OK : 0) | packRelays(aquecimento, resfriamento, degelo))};
+    traceAppend(TRACE_RESPOSTA, &resposta, sizeof(resposta));
+}
+
+void traceConfig() {
+    TraceConfig config = {savedDegeloModo == "por_temperatura", savedDegeloTemperatura, savedTemperaturaMinSeguranca,
+                          savedTemperaturaMaxSeguranca, savedTemperaturaAlvoLocal, savedVariacaoTemperaturaLocal};
+    traceAppend(TRACE_CONFIG, &config, sizeof(config));
+}
+
+void traceDecision(TraceOrigem origem, bool aquecimento, bool resfriamento, bool degelo) {
+    TraceDecisao decisao = {origem, packRelays(aquecimento, resfriamento, degelo)};
+    traceAppend(TRACE_DECISAO, &decisao, sizeof(decisao));
+}
+
+size_t traceStorageSize() {
+    return tracePartition != nullptr ? traceSectorCount * TRACE_SECTOR_SIZE : 0;
+}
+
+bool traceReadRaw(size_t offset, uint8_t *buffer, size_t length) {
+    if (tracePartition == nullptr || offset + length > traceStorageSize()) {
+        return false;
+    }
+    return esp_partition_read(tracePartition, offset, buffer, length) == ESP_OK;
+}
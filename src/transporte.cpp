@@ -0,0 +1,28 @@
+#include "transporte.h"
+#include "config.h"
+#include "log.h"
+#include "supabase.h"
+#include "mqtt.h"
+
+TelemetryTransport *telemetryTransport = &supabaseTransport;
+
+void selectTelemetryTransport() {
+    if (savedTransporte == "mqtt" && savedMqttHost.length() > 0) {
+        telemetryTransport = &mqttTransport;
+    } else {
+        telemetryTransport = &supabaseTransport;
+    }
+    addLogf("Transporte de telemetria: %s", telemetryTransport->name());
+}
+
+bool readProcessId(JsonVariantConst valor, char *destino, size_t tamanho) {
+    destino[0] = '\0';
+    if (valor.is<const char *>()) {
+        if (strlcpy(destino, valor.as<const char *>(), tamanho) >= tamanho) {
+            destino[0] = '\0';
+        }
+    } else if (valor.is<long long>()) {
+        snprintf(destino, tamanho, "%lld", valor.as<long long>());
+    }
+    return destino[0] != '\0';
+}
@@ -2,6 +2,7 @@
 #include "config.h"
 #include "log.h"
 #include "api.h"
+#include "transporte.h"
 #include <WiFi.h>
 #include <WiFiAP.h>
 
@@ -25,7 +26,7 @@ void startAPMode() {
     addLog("Servidor HTTP iniciado no modo AP");
 }
 
-String getWiFiStatusString(int status) {
+const char *getWiFiStatusString(int status) {
     switch (status) {
         case WL_NO_SHIELD: return "WL_NO_SHIELD";
         case WL_IDLE_STATUS: return "WL_IDLE_STATUS";
@@ -35,7 +36,7 @@ String getWiFiStatusString(int status) {
         case WL_CONNECT_FAILED: return "WL_CONNECT_FAILED";
         case WL_CONNECTION_LOST: return "WL_CONNECTION_LOST";
         case WL_DISCONNECTED: return "WL_DISCONNECTED";
-        default: return "UNKNOWN (" + String(status) + ")";
+        default: return "UNKNOWN";
     }
 }
 
@@ -68,7 +69,7 @@ void connectToWiFi() {
     unsigned long startTime = millis();
     while (WiFi.status() != WL_CONNECTED && millis() - startTime < WIFI_TIMEOUT) {
         int status = WiFi.status();
-        addLog("Status: " + getWiFiStatusString(status) + " | Tentativa: " + String((millis() - startTime) / 1000) + "s");
+        addLogf("Status: %s | Tentativa: %lus", getWiFiStatusString(status), (millis() - startTime) / 1000);
         if (status == WL_NO_SSID_AVAIL) {
             addLog("Rede não encontrada - Verifique o nome");
             break;
@@ -78,13 +79,11 @@ void connectToWiFi() {
     if (WiFi.status() == WL_CONNECTED) {
         wifiConnected = true;
         addLog("Conectado! IP: " + WiFi.localIP().toString() + " | RSSI: " + WiFi.RSSI() + "dBm");
-        extern bool validateDeviceOnSupabase();
-        extern bool getActiveProcessOnSupabase();
-        if (validateDeviceOnSupabase()) {
-            processFound = getActiveProcessOnSupabase();
+        if (telemetryTransport->validateDevice()) {
+            processFound = telemetryTransport->getActiveProcess();
         }
     } else {
-        addLog("Falha na conexão - Último status: " + getWiFiStatusString(WiFi.status()));
+        addLogf("Falha na conexão - Último status: %s", getWiFiStatusString(WiFi.status()));
         startAPMode();
     }
 }
@@ -95,11 +94,11 @@ void checkWiFiConnection() {
     if (millis() - lastCheck >= checkInterval) {
         lastCheck = millis();
         int status = WiFi.status();
-        addLog("Verificação WiFi - Status: " + getWiFiStatusString(status));
+        addLogf("Verificação WiFi - Status: %s", getWiFiStatusString(status));
         if (status != WL_CONNECTED) {
             wifiConnected = false;
             wifiErrorCount++;
-            addLog("WiFi desconectado. Tentativas: " + String(wifiErrorCount));
+            addLogf("WiFi desconectado. Tentativas: %d", wifiErrorCount);
             if (wifiErrorCount >= MAX_WIFI_ERRORS && !apModeActive) {
                 addLog("Máximo de tentativas alcançado - Ativando modo AP");
                 startAPMode();
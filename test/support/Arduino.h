@@ -0,0 +1,50 @@
+#ifndef FERMENSTATION_TEST_ARDUINO_H
+#define FERMENSTATION_TEST_ARDUINO_H
+
+#include <algorithm>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using std::max;
+using std::min;
+
+inline unsigned long &fakeMillis() {
+    static unsigned long now = 0;
+    return now;
+}
+
+inline unsigned long millis() {
+    return fakeMillis();
+}
+
+inline unsigned long micros() {
+    return fakeMillis() * 1000UL;
+}
+
+inline void delay(unsigned long ms) {
+    fakeMillis() += ms;
+}
+
+class String {
+public:
+    String(const char *value = "") : value(value) {}
+    const char *c_str() const { return value; }
+    unsigned int length() const { return strlen(value); }
+    bool operator==(const char *other) const { return strcmp(value, other) == 0; }
+
+private:
+    const char *value;
+};
+
+class HardwareSerial {
+public:
+    void println(const char *) {}
+};
+
+inline HardwareSerial Serial;
+
+#endif // FERMENSTATION_TEST_ARDUINO_H
@@ -0,0 +1,6 @@
+#ifndef FERMENSTATION_TEST_PREFERENCES_H
+#define FERMENSTATION_TEST_PREFERENCES_H
+
+class Preferences {};
+
+#endif // FERMENSTATION_TEST_PREFERENCES_H
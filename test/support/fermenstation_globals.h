@@ -0,0 +1,20 @@
+#ifndef FERMENSTATION_TEST_GLOBALS_H
+#define FERMENSTATION_TEST_GLOBALS_H
+
+#include "config.h"
+
+char logs[MAX_LOGS][LOG_LINE_SIZE];
+int currentLogIndex = 0;
+bool logBufferFull = false;
+bool currentRelayAquecimentoState = false;
+bool currentRelayResfriamentoState = false;
+bool currentRelayDegeloState = false;
+float savedTemperaturaMinSeguranca = 0.0;
+float savedTemperaturaMaxSeguranca = 35.0;
+float savedTelemetriaDeadband = 0.2;
+unsigned long savedTelemetriaHeartbeatS = 600;
+float savedTelemetriaRampa = 1.0;
+unsigned long savedTelemetriaControleS = 120;
+const unsigned long SENSOR_READ_INTERVAL_MS = 30000;
+
+#endif // FERMENSTATION_TEST_GLOBALS_H
@@ -0,0 +1,189 @@
+#include <unity.h>
+#include "fermenstation_globals.h"
+#include "bounded_reader.h"
+#include "json_pool.h"
+
+// Stream falso que entrega o corpo em fragmentos; cada fragmento chega
+// depois de um atraso e só é lido se o timeout atual do stream permitir.
+// Sem mais dados, espera o timeout inteiro como Stream::readBytes().
+struct FragmentedStream {
+    const char *const *fragments;
+    const unsigned long *delays;
+    size_t count;
+    size_t fragment;
+    size_t offset;
+    bool arrived;
+    unsigned long timeout;
+    unsigned long maxTimeoutSeen;
+
+    FragmentedStream(const char *const *fragments, const unsigned long *delays, size_t count)
+        : fragments(fragments), delays(delays), count(count), fragment(0), offset(0), arrived(false), timeout(1000),
+          maxTimeoutSeen(0) {}
+
+    void setTimeout(unsigned long value) {
+        timeout = value;
+        if (value > maxTimeoutSeen)
+            maxTimeoutSeen = value;
+    }
+
+    size_t readBytes(char *buffer, size_t length) {
+        size_t total = 0;
+        while (total < length && fragment < count) {
+            if (!arrived) {
+                if (delays[fragment] > timeout) {
+                    delay(timeout);
+                    return total;
+                }
+                delay(delays[fragment]);
+                arrived = true;
+            }
+            const char *data = fragments[fragment];
+            while (total < length && data[offset] != '\0') {
+                buffer[total++] = data[offset++];
+            }
+            if (data[offset] == '\0') {
+                fragment++;
+                offset = 0;
+                arrived = false;
+            }
+        }
+        if (total < length) {
+            delay(timeout);
+        }
+        return total;
+    }
+};
+
+static uint8_t poolBuffer[JSON_POOL_SIZE_FOR(1, 1024)] __attribute__((aligned(8)));
+static JsonPoolAllocator pool(poolBuffer, sizeof(poolBuffer));
+static uint8_t filterBuffer[JSON_POOL_SIZE_FOR(1, 0)] __attribute__((aligned(8)));
+static JsonPoolAllocator filterPool(filterBuffer, sizeof(filterBuffer));
+
+static const unsigned long TIMEOUT_MS = 5000;
+static const size_t MAX_SIZE = 256;
+static const uint8_t NESTING_LIMIT = 4;
+
+static BoundedJsonResult parse(JsonDocument &doc, FragmentedStream &stream, int contentLength) {
+    JsonDocument filter(&filterPool);
+    filter.set(true);
+    TEST_ASSERT_FALSE(filter.overflowed());
+    return deserializeBoundedJson(doc, stream, contentLength, MAX_SIZE, TIMEOUT_MS, filter, NESTING_LIMIT);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_fragmented_body_is_parsed(void) {
+    const char *fragments[] = {"{\"releAquecim", "ento\":true,\"acaoTo", "mada\":\"Aquecendo\"}"};
+    const unsigned long delays[] = {100, 800, 1200};
+    FragmentedStream stream(fragments, delays, 3);
+    JsonDocument doc(&pool);
+
+    BoundedJsonResult result = parse(doc, stream, 49);
+
+    TEST_ASSERT_FALSE(result.error);
+    TEST_ASSERT_FALSE(result.timedOut);
+    TEST_ASSERT_EQUAL_UINT32(49, result.consumed);
+    TEST_ASSERT_TRUE(doc["releAquecimento"] | false);
+    TEST_ASSERT_EQUAL_STRING("Aquecendo", doc["acaoTomada"] | "");
+    TEST_ASSERT_EQUAL_UINT32(0, pool.failures());
+}
+
+void test_truncated_body_is_incomplete(void) {
+    const char *fragments[] = {"{\"releAquecimento\":tr"};
+    const unsigned long delays[] = {0};
+    FragmentedStream stream(fragments, delays, 1);
+    JsonDocument doc(&pool);
+
+    BoundedJsonResult result = parse(doc, stream, 40);
+
+    TEST_ASSERT_TRUE(result.error == DeserializationError::IncompleteInput);
+    TEST_ASSERT_TRUE(result.timedOut);
+}
+
+void test_declared_length_over_cap_is_rejected_unread(void) {
+    const char *fragments[] = {"{}"};
+    const unsigned long delays[] = {0};
+    FragmentedStream stream(fragments, delays, 1);
+    JsonDocument doc(&pool);
+
+    BoundedJsonResult result = parse(doc, stream, MAX_SIZE + 1);
+
+    TEST_ASSERT_TRUE(result.tooLarge);
+    TEST_ASSERT_TRUE(result.error);
+    TEST_ASSERT_EQUAL_UINT32(0, result.consumed);
+    TEST_ASSERT_EQUAL_UINT32(0, stream.fragment);
+}
+
+void test_body_without_length_stops_at_cap(void) {
+    static char body[MAX_SIZE * 2];
+    body[0] = '"';
+    memset(body + 1, 'x', sizeof(body) - 3);
+    body[sizeof(body) - 2] = '"';
+    body[sizeof(body) - 1] = '\0';
+    const char *fragments[] = {body};
+    const unsigned long delays[] = {0};
+    FragmentedStream stream(fragments, delays, 1);
+    JsonDocument doc(&pool);
+
+    BoundedJsonResult result = parse(doc, stream, -1);
+
+    TEST_ASSERT_TRUE(result.error == DeserializationError::IncompleteInput);
+    TEST_ASSERT_EQUAL_UINT32(MAX_SIZE, result.consumed);
+}
+
+void test_deep_nesting_is_rejected(void) {
+    const char *fragments[] = {"{\"a\":[[[[[[1]]]]]]}"};
+    const unsigned long delays[] = {0};
+    FragmentedStream stream(fragments, delays, 1);
+    JsonDocument doc(&pool);
+
+    BoundedJsonResult result = parse(doc, stream, -1);
+
+    TEST_ASSERT_TRUE(result.error == DeserializationError::TooDeep);
+}
+
+void test_small_pool_reports_no_memory(void) {
+    static uint8_t smallBuffer[64] __attribute__((aligned(8)));
+    JsonPoolAllocator smallPool(smallBuffer, sizeof(smallBuffer));
+    const char *fragments[] = {"{\"acaoTomada\":\"Resfriamento solicitado pela receita ativa\",\"historico\":[1,2,3,4,5]}"};
+    const unsigned long delays[] = {0};
+    FragmentedStream stream(fragments, delays, 1);
+    BoundedJsonResult result;
+    {
+        JsonDocument doc(&smallPool);
+        result = parse(doc, stream, -1);
+    }
+
+    TEST_ASSERT_TRUE(result.error == DeserializationError::NoMemory);
+    TEST_ASSERT_EQUAL_UINT32(0, smallPool.used());
+}
+
+void test_deadline_covers_whole_body(void) {
+    const char *fragments[] = {"{\"a\":", "1,\"b\":", "2}"};
+    const unsigned long delays[] = {2000, 2000, 2000};
+    FragmentedStream stream(fragments, delays, 3);
+    JsonDocument doc(&pool);
+    unsigned long start = millis();
+
+    BoundedJsonResult result = parse(doc, stream, 13);
+
+    TEST_ASSERT_TRUE(result.error == DeserializationError::IncompleteInput);
+    TEST_ASSERT_TRUE(result.timedOut);
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT_MS, millis() - start);
+    TEST_ASSERT_EQUAL_UINT32(TIMEOUT_MS, stream.maxTimeoutSeen);
+    TEST_ASSERT_EQUAL_UINT32(1000, stream.timeout);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fragmented_body_is_parsed);
+    RUN_TEST(test_truncated_body_is_incomplete);
+    RUN_TEST(test_declared_length_over_cap_is_rejected_unread);
+    RUN_TEST(test_body_without_length_stops_at_cap);
+    RUN_TEST(test_deep_nesting_is_rejected);
+    RUN_TEST(test_small_pool_reports_no_memory);
+    RUN_TEST(test_deadline_covers_whole_body);
+    return UNITY_END();
+}
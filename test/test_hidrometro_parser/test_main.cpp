@@ -0,0 +1,99 @@
+#include <unity.h>
+#include "fermenstation_globals.h"
+#include "hidrometro_parser.h"
+#include <math.h>
+#include <string.h>
+
+static uint8_t poolBuffer[HYDROMETER_JSON_POOL_SIZE] __attribute__((aligned(8)));
+static JsonPoolAllocator pool(poolBuffer, sizeof(poolBuffer));
+
+static bool parse(const char *json, HydrometerGravityUnit unidade, HydrometerPacket &packet) {
+    bool valido = parseHydrometerPacket(json, strlen(json), unidade, pool, packet);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.used());
+    return valido;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_ispindel_sg_packet(void) {
+    HydrometerPacket packet;
+    TEST_ASSERT_TRUE(parse("{\"name\":\"iSpindel001\",\"ID\":1234567,\"angle\":52.3,\"temperature\":19.5,"
+                           "\"temp_units\":\"C\",\"battery\":4.1,\"gravity\":1.0452,\"RSSI\":-70}",
+                           HIDROMETRO_SG, packet));
+    TEST_ASSERT_EQUAL_UINT32(1234567, packet.id);
+    TEST_ASSERT_EQUAL_STRING("iSpindel001", packet.nome);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 1.0452, packet.gravidade);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 19.5, packet.temperatura);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.failures());
+}
+
+void test_plato_comes_from_configured_unit(void) {
+    HydrometerPacket packet;
+    const char *json = "{\"name\":\"a\",\"gravity\":1.2}";
+    TEST_ASSERT_TRUE(parse(json, HIDROMETRO_PLATO, packet));
+    TEST_ASSERT_FLOAT_WITHIN(0.0002, 1.0047, packet.gravidade);
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":12.0}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_TRUE(parse("{\"name\":\"a\",\"gravity\":12.0}", HIDROMETRO_PLATO, packet));
+    TEST_ASSERT_FLOAT_WITHIN(0.0005, 1.0484, packet.gravidade);
+}
+
+void test_gravity_unit_field_overrides_setting(void) {
+    HydrometerPacket packet;
+    TEST_ASSERT_TRUE(parse("{\"name\":\"a\",\"gravity\":1.012,\"gravity_unit\":\"G\"}", HIDROMETRO_PLATO, packet));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 1.012, packet.gravidade);
+    TEST_ASSERT_TRUE(parse("{\"name\":\"a\",\"gravity\":0.5,\"gravity_unit\":\"P\"}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FLOAT_WITHIN(0.0002, 1.0019, packet.gravidade);
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":1.012,\"gravity_unit\":\"brix\"}", HIDROMETRO_SG, packet));
+}
+
+void test_temperature_units(void) {
+    HydrometerPacket packet;
+    TEST_ASSERT_TRUE(parse("{\"ID\":1,\"gravity\":1.01,\"temperature\":68.0,\"temp_units\":\"F\"}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 20.0, packet.temperatura);
+    TEST_ASSERT_TRUE(parse("{\"ID\":1,\"gravity\":1.01,\"temperature\":293.15,\"temp_units\":\"K\"}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 20.0, packet.temperatura);
+    TEST_ASSERT_FALSE(parse("{\"ID\":1,\"gravity\":1.01,\"temperature\":20.0,\"temp_units\":\"R\"}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_TRUE(parse("{\"ID\":1,\"gravity\":1.01}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_TRUE(isnan(packet.temperatura));
+}
+
+void test_rejects_invalid_packets(void) {
+    HydrometerPacket packet;
+    TEST_ASSERT_FALSE(parse("", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\"}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FALSE(parse("{\"gravity\":1.01}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":\"1.01\"}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":1.01,\"angle\":120}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":1.01,\"battery\":9}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":45.0}", HIDROMETRO_PLATO, packet));
+    TEST_ASSERT_FALSE(parse("{\"name\":\"a\",\"gravity\":1.01", HIDROMETRO_SG, packet));
+}
+
+void test_long_name_is_truncated(void) {
+    HydrometerPacket packet;
+    TEST_ASSERT_TRUE(parse("{\"name\":\"hidrometro-com-um-nome-bem-comprido\",\"gravity\":1.01}", HIDROMETRO_SG, packet));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(packet.nome) - 1, strlen(packet.nome));
+}
+
+void test_oversized_packet_is_rejected(void) {
+    static char json[HYDROMETER_MAX_PACKET_SIZE + 16];
+    memset(json, ' ', sizeof(json) - 1);
+    json[sizeof(json) - 1] = '\0';
+    memcpy(json, "{\"name\":\"a\",\"gravity\":1.01}", 27);
+    HydrometerPacket packet;
+    TEST_ASSERT_FALSE(parse(json, HIDROMETRO_SG, packet));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ispindel_sg_packet);
+    RUN_TEST(test_plato_comes_from_configured_unit);
+    RUN_TEST(test_gravity_unit_field_overrides_setting);
+    RUN_TEST(test_temperature_units);
+    RUN_TEST(test_rejects_invalid_packets);
+    RUN_TEST(test_long_name_is_truncated);
+    RUN_TEST(test_oversized_packet_is_rejected);
+    return UNITY_END();
+}
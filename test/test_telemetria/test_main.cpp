@@ -0,0 +1,111 @@
+#include <unity.h>
+#include "fermenstation_globals.h"
+#include "telemetria.h"
+
+static TelemetryReason cycle(float tempFermentador, bool pollControl) {
+    delay(SENSOR_READ_INTERVAL_MS);
+    TelemetryReason reason = evaluateTelemetry(tempFermentador, 21.0, 4.0, -1.0, pollControl);
+    if (reason != TELEMETRIA_SUPRIMIDA) {
+        markTelemetrySent(tempFermentador, 21.0, 4.0, -1.0);
+    }
+    return reason;
+}
+
+void setUp(void) {
+    savedTelemetriaDeadband = 0.2;
+    savedTelemetriaHeartbeatS = 600;
+    savedTelemetriaControleS = 120;
+    savedTelemetriaRampa = 1000.0;
+    savedTemperaturaMinSeguranca = 0.0;
+    savedTemperaturaMaxSeguranca = 35.0;
+    currentRelayAquecimentoState = false;
+    resetTelemetry();
+}
+
+void tearDown(void) {}
+
+void test_steady_readings_are_suppressed_until_heartbeat(void) {
+    TEST_ASSERT_EQUAL(TELEMETRIA_PRIMEIRA, cycle(20.0, false));
+    int suprimidas = 0;
+    TelemetryReason reason;
+    while ((reason = cycle(20.05, false)) == TELEMETRIA_SUPRIMIDA) {
+        suprimidas++;
+    }
+    TEST_ASSERT_EQUAL(TELEMETRIA_HEARTBEAT, reason);
+    TEST_ASSERT_EQUAL(600 / 30 - 1, suprimidas);
+    TEST_ASSERT_EQUAL_UINT32(2, telemetryStats.enviados);
+    TEST_ASSERT_EQUAL_UINT32(suprimidas, telemetryStats.suprimidos);
+    TEST_ASSERT_EQUAL_UINT32(suprimidas, telemetryStats.porMotivo[TELEMETRIA_SUPRIMIDA]);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.porMotivo[TELEMETRIA_PRIMEIRA]);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.porMotivo[TELEMETRIA_HEARTBEAT]);
+}
+
+void test_control_poll_bounds_cloud_control_delay(void) {
+    TEST_ASSERT_EQUAL(TELEMETRIA_PRIMEIRA, cycle(25.0, true));
+    int suprimidas = 0;
+    TelemetryReason reason;
+    while ((reason = cycle(25.05, true)) == TELEMETRIA_SUPRIMIDA) {
+        suprimidas++;
+    }
+    TEST_ASSERT_EQUAL(TELEMETRIA_CONTROLE, reason);
+    TEST_ASSERT_EQUAL(120 / 30 - 1, suprimidas);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.porMotivo[TELEMETRIA_CONTROLE]);
+    TEST_ASSERT_EQUAL_UINT32(0, telemetryStats.porMotivo[TELEMETRIA_HEARTBEAT]);
+}
+
+void test_deadband_and_relay_changes_are_sent(void) {
+    TEST_ASSERT_EQUAL(TELEMETRIA_PRIMEIRA, cycle(30.0, false));
+    TEST_ASSERT_EQUAL(TELEMETRIA_DEADBAND, cycle(30.3, false));
+    currentRelayAquecimentoState = true;
+    TEST_ASSERT_EQUAL(TELEMETRIA_RELE, cycle(30.3, false));
+    TEST_ASSERT_EQUAL(TELEMETRIA_SUPRIMIDA, cycle(30.3, false));
+    markTelemetryFailed();
+    TEST_ASSERT_EQUAL_UINT32(3, telemetryStats.enviados);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.suprimidos);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.falhas);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.porMotivo[TELEMETRIA_DEADBAND]);
+    TEST_ASSERT_EQUAL_UINT32(1, telemetryStats.porMotivo[TELEMETRIA_RELE]);
+}
+
+void test_ramp_switches_to_fast_interval(void) {
+    savedTelemetriaDeadband = 5.0;
+    savedTelemetriaRampa = 2.0;
+    TEST_ASSERT_EQUAL(TELEMETRIA_PRIMEIRA, cycle(20.0, false));
+    int ciclosJanela = TELEMETRY_RAMP_WINDOW_MS / SENSOR_READ_INTERVAL_MS;
+    for (int i = 1; i < ciclosJanela; i++) {
+        TEST_ASSERT_EQUAL(TELEMETRIA_SUPRIMIDA, cycle(20.0 + 0.1 * i, false));
+        TEST_ASSERT_EQUAL_UINT32(SENSOR_READ_INTERVAL_MS, getTelemetryInterval());
+    }
+    // 1 °C em 5 minutos = 12 °C/h, acima do limite de 2 °C/h.
+    TEST_ASSERT_EQUAL(TELEMETRIA_RAMPA, cycle(21.0, false));
+    TEST_ASSERT_EQUAL_UINT32(TELEMETRY_FAST_INTERVAL_MS, getTelemetryInterval());
+    for (int i = 1; i < ciclosJanela; i++) {
+        TEST_ASSERT_EQUAL(TELEMETRIA_RAMPA, cycle(21.0, false));
+    }
+    TEST_ASSERT_EQUAL(TELEMETRIA_SUPRIMIDA, cycle(21.0, false));
+    TEST_ASSERT_EQUAL_UINT32(SENSOR_READ_INTERVAL_MS, getTelemetryInterval());
+    TEST_ASSERT_EQUAL_UINT32(ciclosJanela, telemetryStats.porMotivo[TELEMETRIA_RAMPA]);
+}
+
+void test_alarm_switches_to_fast_interval(void) {
+    TEST_ASSERT_EQUAL(TELEMETRIA_PRIMEIRA, cycle(20.0, false));
+    TEST_ASSERT_EQUAL_UINT32(SENSOR_READ_INTERVAL_MS, getTelemetryInterval());
+    TEST_ASSERT_EQUAL(TELEMETRIA_ALARME, cycle(36.0, false));
+    TEST_ASSERT_EQUAL_UINT32(TELEMETRY_FAST_INTERVAL_MS, getTelemetryInterval());
+    TEST_ASSERT_EQUAL(TELEMETRIA_ALARME, cycle(-1.0, false));
+    TEST_ASSERT_EQUAL_UINT32(TELEMETRY_FAST_INTERVAL_MS, getTelemetryInterval());
+    TEST_ASSERT_EQUAL(TELEMETRIA_DEADBAND, cycle(20.0, false));
+    TEST_ASSERT_EQUAL_UINT32(SENSOR_READ_INTERVAL_MS, getTelemetryInterval());
+    TEST_ASSERT_EQUAL_UINT32(2, telemetryStats.porMotivo[TELEMETRIA_ALARME]);
+    TEST_ASSERT_EQUAL_UINT32(4, telemetryStats.enviados);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_readings_are_suppressed_until_heartbeat);
+    RUN_TEST(test_control_poll_bounds_cloud_control_delay);
+    RUN_TEST(test_deadband_and_relay_changes_are_sent);
+    RUN_TEST(test_ramp_switches_to_fast_interval);
+    RUN_TEST(test_alarm_switches_to_fast_interval);
+    return UNITY_END();
+}
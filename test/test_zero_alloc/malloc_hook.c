@@ -0,0 +1,60 @@
+#include "malloc_hook.h"
+#include <stdlib.h>
+
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void __libc_free(void *pointer);
+
+static volatile int counting = 0;
+static volatile size_t allocations = 0;
+
+void *malloc(size_t size) {
+    if (counting)
+        allocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    if (counting)
+        allocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) {
+    if (counting)
+        allocations++;
+    return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer) {
+    if (counting && pointer != NULL)
+        allocations++;
+    __libc_free(pointer);
+}
+
+int mallocHookAvailable(void) {
+    return 1;
+}
+
+void mallocHookBegin(void) {
+    allocations = 0;
+    counting = 1;
+}
+
+size_t mallocHookEnd(void) {
+    counting = 0;
+    return allocations;
+}
+#else
+int mallocHookAvailable(void) {
+    return 0;
+}
+
+void mallocHookBegin(void) {}
+
+size_t mallocHookEnd(void) {
+    return 0;
+}
+#endif
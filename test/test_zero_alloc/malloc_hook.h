@@ -0,0 +1,18 @@
+#ifndef MALLOC_HOOK_H
+#define MALLOC_HOOK_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int mallocHookAvailable(void);
+void mallocHookBegin(void);
+size_t mallocHookEnd(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MALLOC_HOOK_H
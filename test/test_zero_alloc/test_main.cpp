@@ -0,0 +1,113 @@
+#include <unity.h>
+#include "fermenstation_globals.h"
+#include "controle_logica.h"
+#include "json_pool.h"
+#include "log.h"
+#include "malloc_hook.h"
+#include "telemetria.h"
+#include <ArduinoJson.h>
+
+static uint8_t poolBuffer[JSON_POOL_SIZE] __attribute__((aligned(8)));
+static JsonPoolAllocator pool(poolBuffer, sizeof(poolBuffer));
+static char payload[SUPABASE_PAYLOAD_SIZE];
+static char deviceId[] = "fermentador-teste-01";
+static const char response[] =
+    "{\"status\":\"ok\",\"releAquecimento\":true,\"releResfriamento\":false,\"releDegelo\":false,"
+    "\"acaoTomada\":\"Aquecimento solicitado pela receita\",\"historico\":[1,2,3,4,5,6,7,8]}";
+
+static bool runCycle(float tempFermentador) {
+    ControlParams params = {false, 5.0, 0.0, 35.0, 20.0, 0.5};
+    ControlDecision decision = decideLocalControl(params, tempFermentador, 21.0, 4.0);
+    currentRelayAquecimentoState = decision.aquecimento;
+    currentRelayResfriamentoState = decision.resfriamento;
+    currentRelayDegeloState = decision.degelo;
+    addLogf("Temperaturas lidas: Fermentador=%.2f°C, Ambiente=%.2f°C, Degelo=%.2f°C", tempFermentador, 21.0, 4.0);
+    addLogf("Ação tomada localmente: %s", decision.acao);
+
+    TelemetryReason reason = evaluateTelemetry(tempFermentador, 21.0, 4.0, 1.012, true);
+    JsonDocument doc(&pool);
+    doc["p_device_id"] = (const char *)deviceId;
+    doc["p_temp_fermentador"] = tempFermentador;
+    doc["p_temp_ambiente"] = 21.0;
+    doc["p_temp_degelo"] = 4.0;
+    doc["p_gravidade"] = 1.012;
+    size_t length = serializeJson(doc, payload, sizeof(payload));
+    doc.clear();
+
+    JsonDocument filter(&pool);
+    filter["releAquecimento"] = true;
+    filter["releResfriamento"] = true;
+    filter["releDegelo"] = true;
+    filter["acaoTomada"] = true;
+    DeserializationError error = deserializeJson(doc, response, DeserializationOption::Filter(filter));
+    if (reason != TELEMETRIA_SUPRIMIDA) {
+        markTelemetrySent(tempFermentador, 21.0, 4.0, 1.012);
+    }
+    addLogf("Ação tomada pelo Supabase: %s", doc["acaoTomada"] | "");
+    delay(30000);
+    return length > 0 && !filter.overflowed() && !error && (doc["releAquecimento"] | false);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_steady_state_cycle_does_not_allocate(void) {
+    if (!mallocHookAvailable()) {
+        TEST_IGNORE_MESSAGE("malloc hook requires glibc");
+    }
+    TEST_ASSERT_TRUE(runCycle(18.0));
+    TEST_ASSERT_TRUE(runCycle(18.1));
+
+    mallocHookBegin();
+    bool ok = runCycle(18.2);
+    ok = runCycle(18.6) && ok;
+    size_t allocations = mallocHookEnd();
+
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+    TEST_ASSERT_EQUAL_UINT32(0, pool.used());
+    TEST_ASSERT_EQUAL_UINT32(0, pool.failures());
+}
+
+void test_exhausted_pool_fails_without_heap(void) {
+    if (!mallocHookAvailable()) {
+        TEST_IGNORE_MESSAGE("malloc hook requires glibc");
+    }
+    static uint8_t smallBuffer[64] __attribute__((aligned(8)));
+    JsonPoolAllocator smallPool(smallBuffer, sizeof(smallBuffer));
+
+    mallocHookBegin();
+    DeserializationError error;
+    {
+        JsonDocument doc(&smallPool);
+        error = deserializeJson(doc, response);
+    }
+    size_t allocations = mallocHookEnd();
+
+    TEST_ASSERT_TRUE(error == DeserializationError::NoMemory);
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+    TEST_ASSERT_EQUAL_UINT32(0, smallPool.used());
+}
+
+void test_add_logf_truncates_to_line_size(void) {
+    char longMessage[LOG_LINE_SIZE * 2];
+    memset(longMessage, 'x', sizeof(longMessage) - 1);
+    longMessage[sizeof(longMessage) - 1] = '\0';
+    int index = currentLogIndex;
+
+    mallocHookBegin();
+    addLogf("%s", longMessage);
+    size_t allocations = mallocHookEnd();
+
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+    TEST_ASSERT_EQUAL_UINT32(LOG_LINE_SIZE - 1, strlen(logs[index]));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_state_cycle_does_not_allocate);
+    RUN_TEST(test_exhausted_pool_fails_without_heap);
+    RUN_TEST(test_add_logf_truncates_to_line_size);
+    return UNITY_END();
+}
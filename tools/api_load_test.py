@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Teste de carga da API local do FermenStation.
+
+Dispara requisições concorrentes contra os endpoints GET, reaproveitando o
+ETag recebido (If-None-Match), e resume códigos de status e latências.
+
+Uso: python3 tools/api_load_test.py 192.168.0.1 --clientes 8 --duracao 30
+"""
+
+import argparse
+import http.client
+import statistics
+import threading
+import time
+from collections import Counter
+
+ENDPOINTS = ["/api/config", "/api/readings", "/api/status", "/api/logs"]
+
+
+def worker(host, porta, endpoints, fim, resultados, lock):
+    etags = {}
+    indice = 0
+    while time.monotonic() < fim:
+        endpoint = endpoints[indice % len(endpoints)]
+        indice += 1
+        cabecalhos = {}
+        if endpoint in etags:
+            cabecalhos["If-None-Match"] = etags[endpoint]
+        inicio = time.monotonic()
+        try:
+            conexao = http.client.HTTPConnection(host, porta, timeout=5)
+            conexao.request("GET", endpoint, headers=cabecalhos)
+            resposta = conexao.getresponse()
+            resposta.read()
+            status = resposta.status
+            etag = resposta.getheader("ETag")
+            if etag:
+                etags[endpoint] = etag
+            conexao.close()
+        except (OSError, http.client.HTTPException):
+            status = "erro"
+        latencia = (time.monotonic() - inicio) * 1000.0
+        with lock:
+            resultados.append((endpoint, status, latencia))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("--porta", type=int, default=80)
+    parser.add_argument("--clientes", type=int, default=8)
+    parser.add_argument("--duracao", type=float, default=30.0)
+    parser.add_argument("--endpoint", action="append", help="endpoint a testar (padrão: todos os GET)")
+    args = parser.parse_args()
+
+    endpoints = args.endpoint or ENDPOINTS
+    resultados = []
+    lock = threading.Lock()
+    fim = time.monotonic() + args.duracao
+    threads = [
+        threading.Thread(target=worker, args=(args.host, args.porta, endpoints, fim, resultados, lock))
+        for _ in range(args.clientes)
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    print(f"{len(resultados)} requisições em {args.duracao:.0f} s ({len(resultados) / args.duracao:.1f}/s)")
+    for endpoint in endpoints:
+        dados = [r for r in resultados if r[0] == endpoint]
+        if not dados:
+            continue
+        codigos = Counter(str(r[1]) for r in dados)
+        latencias = sorted(r[2] for r in dados)
+        p95 = latencias[int(len(latencias) * 0.95) - 1] if len(latencias) >= 20 else latencias[-1]
+        print(f"{endpoint}: {dict(codigos)} | mediana {statistics.median(latencias):.0f} ms, p95 {p95:.0f} ms")
+
+
+if __name__ == "__main__":
+    main()
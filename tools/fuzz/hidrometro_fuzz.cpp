@@ -0,0 +1,34 @@
+// Alvo libFuzzer para parseHydrometerPacket(). Ver README ("Hidrômetros sem fio").
+#include "hidrometro_parser.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void checkPacket(const HydrometerPacket &packet) {
+    if (memchr(packet.nome, '\0', sizeof(packet.nome)) == nullptr) {
+        abort();
+    }
+    if (!(packet.gravidade >= 0.980 && packet.gravidade <= 1.200)) {
+        abort();
+    }
+    if (!isnan(packet.temperatura) && !(packet.temperatura >= -10.0 && packet.temperatura <= 110.0)) {
+        abort();
+    }
+}
+
+static uint8_t poolBuffer[HYDROMETER_JSON_POOL_SIZE] __attribute__((aligned(8)));
+static JsonPoolAllocator pool(poolBuffer, sizeof(poolBuffer));
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    HydrometerPacket packet;
+    if (parseHydrometerPacket((const char *)data, size, HIDROMETRO_SG, pool, packet)) {
+        checkPacket(packet);
+    }
+    if (parseHydrometerPacket((const char *)data, size, HIDROMETRO_PLATO, pool, packet)) {
+        checkPacket(packet);
+    }
+    if (pool.used() != 0) {
+        abort();
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Teste de fumaça do transporte MQTT do FermenStation.
+
+Usa os clientes mosquitto_pub/mosquitto_sub contra o broker configurado no
+dispositivo e percorre os tópicos documentados no README:
+
+1. publica um processo ativo (retido) em fermenstation/<id>/processo;
+2. espera `online` em fermenstation/<id>/status;
+3. espera uma telemetria em fermenstation/<id>/telemetria com o processo publicado;
+4. publica um comando (retido) em fermenstation/<id>/comando e, se o IP do
+   dispositivo for informado, confere os relés em GET /api/readings.
+
+Uso: python3 tools/mqtt_smoke_test.py localhost fermentador-01 --dispositivo 192.168.0.50
+"""
+
+import argparse
+import json
+import shutil
+import subprocess
+import sys
+import time
+import urllib.request
+
+
+def mosquitto_args(args):
+    base = ["-h", args.broker, "-p", str(args.porta), "-q", "1"]
+    if args.usuario:
+        base += ["-u", args.usuario, "-P", args.senha or ""]
+    return base
+
+
+def publicar(args, topico, mensagem, retido=True):
+    comando = ["mosquitto_pub"] + mosquitto_args(args) + ["-t", topico]
+    comando += ["-n"] if mensagem is None else ["-m", mensagem]
+    if retido:
+        comando.append("-r")
+    subprocess.run(comando, check=True, timeout=10)
+
+
+def receber(args, topico, aceitar, timeout):
+    comando = ["mosquitto_sub"] + mosquitto_args(args) + ["-t", topico, "-W", str(timeout)]
+    processo = subprocess.Popen(comando, stdout=subprocess.PIPE, text=True)
+    try:
+        for linha in processo.stdout:
+            linha = linha.strip()
+            if aceitar(linha):
+                return linha
+        return None
+    finally:
+        processo.kill()
+        processo.wait()
+
+
+def telemetria_valida(processo_id):
+    def aceitar(linha):
+        campos = linha.split(",")
+        if len(campos) != 5 or campos[0] != processo_id:
+            return False
+        try:
+            [float(campo) for campo in campos[1:]]
+        except ValueError:
+            return False
+        return True
+
+    return aceitar
+
+
+def conferir_reles(dispositivo, esperado, timeout):
+    fim = time.monotonic() + timeout
+    leitura = None
+    while time.monotonic() < fim:
+        try:
+            with urllib.request.urlopen(f"http://{dispositivo}/api/readings", timeout=5) as resposta:
+                leitura = json.load(resposta)
+            if all(leitura.get(chave) == valor for chave, valor in esperado.items()):
+                return True, leitura
+        except (OSError, ValueError):
+            pass
+        time.sleep(1)
+    return False, leitura
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("broker", help="host do broker MQTT")
+    parser.add_argument("device_id", help="deviceId configurado no FermenStation")
+    parser.add_argument("--porta", type=int, default=1883)
+    parser.add_argument("--usuario")
+    parser.add_argument("--senha")
+    parser.add_argument("--dispositivo", help="IP do FermenStation para conferir os relés via /api/readings")
+    parser.add_argument("--processo", default="teste-mqtt", help="process_id publicado")
+    parser.add_argument("--timeout", type=int, default=90, help="segundos de espera por mensagem")
+    parser.add_argument("--manter", action="store_true", help="não limpa as mensagens retidas no final")
+    args = parser.parse_args()
+
+    for programa in ("mosquitto_pub", "mosquitto_sub"):
+        if shutil.which(programa) is None:
+            sys.exit(f"{programa} não encontrado (instale mosquitto-clients)")
+
+    base = f"fermenstation/{args.device_id}"
+    falhas = 0
+
+    processo = {
+        "process_found": True,
+        "process_id": args.processo,
+        "temperatura_alvo_receita": 18.0,
+        "variacao_aceitavel_receita": 0.5,
+    }
+    publicar(args, f"{base}/processo", json.dumps(processo))
+    print(f"processo publicado: {args.processo}")
+
+    status = receber(args, f"{base}/status", lambda linha: linha == "online", args.timeout)
+    print(f"status: {status or 'sem resposta'}")
+    falhas += status is None
+
+    telemetria = receber(args, f"{base}/telemetria", telemetria_valida(args.processo), args.timeout)
+    print(f"telemetria: {telemetria or 'sem resposta'}")
+    falhas += telemetria is None
+
+    comando = {"releAquecimento": True, "releResfriamento": False, "releDegelo": False, "acaoTomada": "Teste MQTT"}
+    publicar(args, f"{base}/comando", json.dumps(comando))
+    print("comando publicado: aquecimento ligado")
+    if args.dispositivo:
+        esperado = {chave: comando[chave] for chave in ("releAquecimento", "releResfriamento", "releDegelo")}
+        ok, leitura = conferir_reles(args.dispositivo, esperado, args.timeout)
+        print(f"relés em /api/readings: {'ok' if ok else 'divergentes'} {leitura}")
+        falhas += not ok
+
+    if not args.manter:
+        publicar(args, f"{base}/comando", None)
+        publicar(args, f"{base}/processo", None)
+
+    print("OK" if falhas == 0 else f"{falhas} verificação(ões) falharam")
+    return 1 if falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
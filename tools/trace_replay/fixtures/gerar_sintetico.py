@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Gera sintetico.trace, o trace de regressão do trace_replay.
+
+O trace imita a gravação do firmware em um anel de 8 setores que já deu a
+volta: cada setor começa com o registro de configuração, o millis() de 32 bits
+estoura no meio da gravação, há um reboot, uma troca de configuração e ciclos
+com controle local e com comandos da nuvem (incluindo combinações de relés que a
+lógica local nunca pede, aplicadas como recebidas). As decisões locais seguem
+controle_logica.cpp, então `trace_replay sintetico.trace` deve terminar sem
+divergências.
+"""
+import math
+import os
+import struct
+
+SECTOR_SIZE = 4096
+SECTORS = 8
+MAGIC = 0x52545346
+BOOT, LEITURA, WIFI, RESPOSTA, CONFIG, DECISAO = 1, 2, 3, 4, 5, 6
+LOCAL, SUPABASE, MQTT = 0, 1, 2
+AQ, RESF, DEG, OK = 0x01, 0x02, 0x04, 0x80
+CYCLE_MS = 30000
+
+
+def f32(value):
+    return struct.unpack("<f", struct.pack("<f", value))[0]
+
+
+def decide_local(config, ferm, deg):
+    por_temperatura, degelo_temp, minimo, maximo, alvo, variacao = config
+    if por_temperatura and deg < degelo_temp:
+        return DEG
+    if ferm < minimo:
+        return AQ
+    if ferm > maximo:
+        return RESF
+    if ferm < f32(alvo - variacao):
+        return AQ
+    if ferm > f32(alvo + variacao):
+        return RESF
+    return 0
+
+
+class Ring:
+    def __init__(self):
+        self.image = bytearray(b"\xff" * SECTOR_SIZE * SECTORS)
+        self.sequence = 0
+        self.sector = -1
+        self.offset = SECTOR_SIZE
+        self.config = None
+
+    def open_sector(self, tempo):
+        self.sequence += 1
+        self.sector = (self.sector + 1) % SECTORS
+        base = self.sector * SECTOR_SIZE
+        self.image[base:base + SECTOR_SIZE] = b"\xff" * SECTOR_SIZE
+        struct.pack_into("<II", self.image, base, MAGIC, self.sequence)
+        self.offset = 8
+        if self.config is not None:
+            self.write_raw(CONFIG, tempo, self.config_payload())
+
+    def config_payload(self):
+        return struct.pack("<Bfffff", *self.config)
+
+    def write_raw(self, tipo, tempo, payload):
+        base = self.sector * SECTOR_SIZE + self.offset
+        struct.pack_into("<BBI", self.image, base, tipo, len(payload), tempo & 0xFFFFFFFF)
+        self.image[base + 6:base + 6 + len(payload)] = payload
+        self.offset += 6 + len(payload)
+
+    def append(self, tipo, tempo, payload=b""):
+        if self.offset + 6 + len(payload) > SECTOR_SIZE:
+            self.open_sector(tempo)
+        self.write_raw(tipo, tempo, payload)
+
+    def set_config(self, tempo, config):
+        self.config = tuple(f32(v) if isinstance(v, float) else v for v in config)
+        self.append(CONFIG, tempo, self.config_payload())
+
+
+def main():
+    ring = Ring()
+    tempo = 0xFFFFFFFF - 700 * CYCLE_MS
+    ring.open_sector(tempo)
+    ring.append(BOOT, tempo)
+    ring.set_config(tempo, (1, 5.0, 0.0, 35.0, 20.0, 0.5))
+    ciclos = 0
+    for ciclo in range(1300):
+        tempo += CYCLE_MS
+        if ciclo == 1000:
+            tempo = 1500
+            ring.append(BOOT, tempo)
+            ring.set_config(tempo, ring.config)
+        if ciclo == 1150:
+            ring.set_config(tempo, (1, 5.0, 0.0, 35.0, 12.0, 0.3))
+        alvo = ring.config[4]
+        ferm = f32(alvo + 2.2 * math.sin(ciclo / 17.0) + 0.05)
+        amb = f32(22.0 + math.cos(ciclo / 40.0))
+        deg = f32(6.0 + 2.5 * math.sin(ciclo / 23.0) + 0.05)
+        ring.append(LEITURA, tempo, struct.pack("<ffff", ferm, amb, deg, 1.012))
+        if ciclo % 50 == 10:
+            ring.append(WIFI, tempo, struct.pack("<i", 5))
+        if 750 <= ciclo < 900:
+            origem = SUPABASE if ciclo < 825 else MQTT
+            pedido = decide_local(ring.config, ferm, deg)
+            if ciclo % 37 == 0:
+                pedido = AQ | RESF
+            if ciclo % 41 == 0:
+                pedido = DEG | AQ
+            ring.append(RESPOSTA, tempo, struct.pack("<BB", origem, OK | pedido))
+            ring.append(DECISAO, tempo + 3, struct.pack("<BB", origem, pedido))
+        else:
+            ring.append(DECISAO, tempo + 2, struct.pack("<BB", LOCAL, decide_local(ring.config, ferm, deg)))
+        ciclos += 1
+    destino = os.path.join(os.path.dirname(os.path.abspath(__file__)), "sintetico.trace")
+    with open(destino, "wb") as arquivo:
+        arquivo.write(ring.image)
+    print(f"{destino}: {ciclos} ciclos, {ring.sequence} setores gravados, {SECTORS} no anel")
+
+
+if __name__ == "__main__":
+    main()
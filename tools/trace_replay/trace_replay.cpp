@@ -0,0 +1,256 @@
+#include "controle_logica.h"
+#include "trace_format.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct Sector {
+    uint32_t sequencia;
+    const uint8_t *data;
+};
+
+struct RelayTimeline {
+    uint8_t reles = 0;
+    uint64_t ultimoTempo = 0;
+    bool iniciado = false;
+    uint32_t comutacoes = 0;
+    uint64_t tempoLigado[3] = {0, 0, 0};
+
+    void update(uint64_t tempo, uint8_t novos) {
+        if (iniciado) {
+            for (int i = 0; i < 3; i++) {
+                if (reles & (1 << i)) {
+                    tempoLigado[i] += tempo - ultimoTempo;
+                }
+            }
+            if (novos != reles) {
+                comutacoes++;
+            }
+        }
+        iniciado = true;
+        reles = novos;
+        ultimoTempo = tempo;
+    }
+};
+
+static uint8_t packDecision(const ControlDecision &decision) {
+    return (decision.aquecimento ? TRACE_RELE_AQUECIMENTO : 0) | (decision.resfriamento ? TRACE_RELE_RESFRIAMENTO : 0) |
+           (decision.degelo ? TRACE_RELE_DEGELO : 0);
+}
+
+static uint8_t replayLocalDecision(ControlParams params, const bool ajustes[5], const float valores[5], const TraceLeitura &leitura) {
+    float *campos[5] = {&params.temperaturaAlvo, &params.variacaoTemperatura, &params.temperaturaMinSeguranca, &params.temperaturaMaxSeguranca,
+                        &params.degeloTemperatura};
+    for (int j = 0; j < 5; j++) {
+        if (ajustes[j]) {
+            *campos[j] = valores[j];
+        }
+    }
+    return packDecision(decideLocalControl(params, leitura.tempFermentador, leitura.tempAmbiente, leitura.tempDegelo));
+}
+
+static void usage(const char *programa) {
+    fprintf(stderr,
+            "Uso: %s <arquivo.trace> [--alvo C] [--variacao C] [--min C] [--max C] [--degelo-temp C] [--simular] [--verbose]\n"
+            "  Sem ajustes, compara cada decisão gravada (local ou da nuvem) com a lógica atual e retorna 1 se houver divergência.\n"
+            "  Decisões locais só são verificadas depois do primeiro registro de configuração.\n"
+            "  --simular aplica a lógica local a todas as leituras, como se o dispositivo estivesse offline.\n",
+            programa);
+}
+
+static void printRelays(const char *titulo, const RelayTimeline &timeline, uint64_t duracao) {
+    const char *nomes[3] = {"aquecimento", "resfriamento", "degelo"};
+    printf("%s: %u comutações", titulo, timeline.comutacoes);
+    for (int i = 0; i < 3; i++) {
+        printf(", %s %.1f%%", nomes[i], duracao > 0 ? 100.0 * timeline.tempoLigado[i] / duracao : 0.0);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    bool ajustes[5] = {false, false, false, false, false};
+    float valores[5] = {0, 0, 0, 0, 0};
+    const char *opcoes[5] = {"--alvo", "--variacao", "--min", "--max", "--degelo-temp"};
+    bool simular = false;
+    bool verbose = false;
+    for (int i = 2; i < argc; i++) {
+        bool reconhecida = false;
+        for (int j = 0; j < 5; j++) {
+            if (strcmp(argv[i], opcoes[j]) == 0 && i + 1 < argc) {
+                ajustes[j] = true;
+                valores[j] = atof(argv[++i]);
+                reconhecida = true;
+            }
+        }
+        if (strcmp(argv[i], "--simular") == 0) {
+            simular = reconhecida = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = reconhecida = true;
+        }
+        if (!reconhecida) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    bool comAjustes = simular;
+    for (int j = 0; j < 5; j++) {
+        comAjustes = comAjustes || ajustes[j];
+    }
+
+    FILE *arquivo = fopen(argv[1], "rb");
+    if (arquivo == nullptr) {
+        perror(argv[1]);
+        return 2;
+    }
+    std::vector<uint8_t> conteudo;
+    uint8_t bloco[TRACE_SECTOR_SIZE];
+    size_t lidos;
+    while ((lidos = fread(bloco, 1, sizeof(bloco), arquivo)) > 0) {
+        conteudo.insert(conteudo.end(), bloco, bloco + lidos);
+    }
+    fclose(arquivo);
+
+    std::vector<Sector> setores;
+    for (size_t offset = 0; offset + TRACE_SECTOR_SIZE <= conteudo.size(); offset += TRACE_SECTOR_SIZE) {
+        TraceSectorHeader header;
+        memcpy(&header, &conteudo[offset], sizeof(header));
+        if (header.magic == TRACE_MAGIC) {
+            setores.push_back({header.sequencia, &conteudo[offset]});
+        }
+    }
+    std::sort(setores.begin(), setores.end(), [](const Sector &a, const Sector &b) { return a.sequencia < b.sequencia; });
+
+    ControlParams params = {false, 5.0, 0.0, 35.0, 20.0, 0.5};
+    TraceLeitura ultimaLeitura = {0, 0, 0, -1};
+    bool temLeitura = false;
+    bool temConfig = false;
+    uint8_t respostaNuvem = 0;
+    bool temRespostaNuvem = false;
+    uint32_t ultimoTempoBruto = 0;
+    uint64_t ultimoTempo = 0;
+    uint64_t primeiroTempo = 0;
+    bool temTempo = false;
+    uint32_t registros[7] = {0, 0, 0, 0, 0, 0, 0};
+    uint32_t verificadas = 0;
+    uint32_t verificadasNuvem = 0;
+    uint32_t divergencias = 0;
+    RelayTimeline gravado;
+    RelayTimeline reproduzido;
+
+    for (const Sector &setor : setores) {
+        size_t offset = sizeof(TraceSectorHeader);
+        while (offset + sizeof(TraceRecordHeader) <= TRACE_SECTOR_SIZE) {
+            TraceRecordHeader header;
+            memcpy(&header, setor.data + offset, sizeof(header));
+            if (header.tipo == TRACE_VAZIO || offset + sizeof(header) + header.tamanho > TRACE_SECTOR_SIZE) {
+                break;
+            }
+            const uint8_t *payload = setor.data + offset + sizeof(header);
+            offset += sizeof(header) + header.tamanho;
+            // tempoMs é o millis() de 32 bits do dispositivo: avança pela diferença
+            // módulo 2^32 (cobre o estouro a cada ~49,7 dias) e recomeça em cada boot.
+            // Pequenos recuos vêm de registros enfileirados fora de ordem e são ignorados.
+            uint32_t delta = header.tempoMs - ultimoTempoBruto;
+            uint64_t tempo = ultimoTempo;
+            bool avanca = true;
+            if (!temTempo) {
+                tempo = primeiroTempo = header.tempoMs;
+                temTempo = true;
+            } else if (header.tipo == TRACE_BOOT) {
+                tempo = ultimoTempo + header.tempoMs;
+            } else if ((int32_t)delta >= 0) {
+                tempo = ultimoTempo + delta;
+            } else {
+                avanca = false;
+            }
+            if (avanca) {
+                ultimoTempoBruto = header.tempoMs;
+            }
+            ultimoTempo = tempo;
+            if (header.tipo < 7) {
+                registros[header.tipo]++;
+            }
+            switch (header.tipo) {
+                case TRACE_CONFIG: {
+                    TraceConfig config;
+                    memcpy(&config, payload, sizeof(config));
+                    params = {config.degeloPorTemperatura != 0, config.degeloTemperatura, config.temperaturaMinSeguranca,
+                              config.temperaturaMaxSeguranca, config.temperaturaAlvo, config.variacaoTemperatura};
+                    temConfig = true;
+                    break;
+                }
+                case TRACE_LEITURA: {
+                    memcpy(&ultimaLeitura, payload, sizeof(ultimaLeitura));
+                    temLeitura = true;
+                    break;
+                }
+                case TRACE_RESPOSTA: {
+                    TraceResposta resposta;
+                    memcpy(&resposta, payload, sizeof(resposta));
+                    if (resposta.flags & TRACE_RESPOSTA_OK) {
+                        // O firmware aplica os relés da nuvem exatamente como recebidos.
+                        respostaNuvem = resposta.flags & (TRACE_RELE_AQUECIMENTO | TRACE_RELE_RESFRIAMENTO | TRACE_RELE_DEGELO);
+                        temRespostaNuvem = true;
+                    }
+                    break;
+                }
+                case TRACE_DECISAO: {
+                    TraceDecisao decisao;
+                    memcpy(&decisao, payload, sizeof(decisao));
+                    gravado.update(tempo, decisao.reles);
+                    if (simular) {
+                        break;
+                    }
+                    uint8_t reles;
+                    if (decisao.origem != TRACE_ORIGEM_LOCAL) {
+                        if (!temRespostaNuvem) {
+                            break;
+                        }
+                        reles = respostaNuvem;
+                        temRespostaNuvem = false;
+                        verificadasNuvem++;
+                    } else {
+                        if (!temLeitura || !temConfig) {
+                            break;
+                        }
+                        reles = replayLocalDecision(params, ajustes, valores, ultimaLeitura);
+                        verificadas++;
+                    }
+                    reproduzido.update(tempo, reles);
+                    if (reles != decisao.reles) {
+                        divergencias++;
+                        if (verbose) {
+                            printf("[%llu ms] divergência (origem %u): gravado=0x%02x reproduzido=0x%02x (fermentador %.2f)\n",
+                                   (unsigned long long)tempo, decisao.origem, decisao.reles, reles, ultimaLeitura.tempFermentador);
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            if (simular && header.tipo == TRACE_LEITURA && temConfig) {
+                reproduzido.update(tempo, replayLocalDecision(params, ajustes, valores, ultimaLeitura));
+            }
+        }
+    }
+
+    gravado.update(ultimoTempo, gravado.reles);
+    reproduzido.update(ultimoTempo, reproduzido.reles);
+    uint64_t duracao = temTempo ? ultimoTempo - primeiroTempo : 0;
+    printf("Setores: %zu, duração: %.1f h\n", setores.size(), duracao / 3600000.0);
+    printf("Registros: boot=%u leitura=%u wifi=%u resposta=%u config=%u decisao=%u\n", registros[TRACE_BOOT], registros[TRACE_LEITURA],
+           registros[TRACE_WIFI], registros[TRACE_RESPOSTA], registros[TRACE_CONFIG], registros[TRACE_DECISAO]);
+    printRelays("Gravado", gravado, duracao);
+    printRelays("Reproduzido", reproduzido, duracao);
+    if (!simular) {
+        printf("Decisões verificadas: locais=%u, nuvem=%u, divergências: %u\n", verificadas, verificadasNuvem, divergencias);
+    }
+    return !comAjustes && divergencias > 0 ? 1 : 0;
+}